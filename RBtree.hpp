@@ -26,7 +26,14 @@ struct	node_base
 	pointer		left;
 	pointer		right;
 
+# ifdef FT_RB_THREADED
+	// In-order neighbours; the header closes the ring, so next of the
+	// rightmost node and prev of the leftmost one is the header
+	pointer		next;
+	pointer		prev;
+# else
 	pointer		n;
+# endif
 
 	static pointer			minimum(pointer n)
 	{
@@ -56,6 +63,24 @@ struct	node_base
 		return n;
 	}
 
+# ifdef FT_RB_THREADED
+	static pointer			increment(pointer n)	{ return n->next; }
+	static pointer			decrement(pointer n)	{ return n->prev; }
+
+	static void				link_after(pointer pos, pointer n)
+	{
+		n->prev = pos;
+		n->next = pos->next;
+		pos->next->prev = n;
+		pos->next = n;
+	}
+
+	static void				unlink(pointer n)
+	{
+		n->prev->next = n->next;
+		n->next->prev = n->prev;
+	}
+# else
 	static pointer			increment(pointer n)
 	{
 		if (n->right) {
@@ -77,10 +102,6 @@ struct	node_base
 		return n;
 	}
 
-	static const_pointer	increment(const_pointer n) {
-		return increment(const_cast<pointer>(n));
-	}
-
 	static pointer			decrement(pointer n)
 	{
 		if (n->color == red && n->parent->parent == n) {
@@ -103,6 +124,11 @@ struct	node_base
 		}
 		return n;
 	}
+# endif
+
+	static const_pointer	increment(const_pointer n) {
+		return increment(const_cast<pointer>(n));
+	}
 
 	static const_pointer	decrement(const_pointer n) {
 		return decrement(const_cast<pointer>(n));
@@ -271,6 +297,10 @@ class	RedBlackTree
 				header.parent = NULL;
 				header.left = &header;
 				header.right = &header;
+# ifdef FT_RB_THREADED
+				header.next = &header;
+				header.prev = &header;
+# endif
 			}
 		};
 
@@ -296,6 +326,9 @@ class	RedBlackTree
 				_leftmost() = _minimum(_root());
 				_rightmost() = _maximum(_root());
 				_tree.node_count = other._tree.node_count;
+# ifdef FT_RB_THREADED
+				_thread_all();
+# endif
 			}
 		}
 
@@ -314,6 +347,9 @@ class	RedBlackTree
 					_leftmost() = _minimum(_root());
 					_rightmost() = _maximum(_root());
 					_tree.node_count = rhs._tree.node_count;
+# ifdef FT_RB_THREADED
+					_thread_all();
+# endif
 				}
 			}
 			return *this;
@@ -378,55 +414,59 @@ class	RedBlackTree
 			return pair<iterator, bool>(it, false);
 		}
 
+		// Constant time when value belongs right before or after pos, at
+		// either end of the tree; otherwise a finger search from pos
 		iterator		insert_unique(iterator pos, value_type const & value)
 		{
-			if (pos.node == _end() || pos.node == _rightmost()) {
-				if (size() > 0
-					&& _tree.key_compare(_key(_rightmost()), KeyOfValue()(value)))
-				{
-					return _insert(0, _rightmost(), value);
-				}
-				else {
-					return insert_unique(value).first;
-				}
-			}
-			else {
-				iterator	after = pos;
-				after++;
-				if (_tree.key_compare(_key(pos.node), KeyOfValue()(value))
-					&& _tree.key_compare(KeyOfValue()(value), _key(after.node)))
-				{
-					if (_right(pos.node)) {
-						return _insert(0, pos.node, value);
-					}
-					else {
-						return _insert(after.node, after.node, value);
-					}
-				}
-				else {
-					return insert_unique(value).first;
-				}
-			}
+			return _insert_near(pos.node, value).first;
 		}
 
+		// Each element is hinted with the previous one, so ascending,
+		// descending and nearly sorted input insert in amortized O(1)
 		template < typename InputIterator >
 		void			insert_unique(InputIterator first, InputIterator last,
 									  typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
 		{
+			base_pointer	hint = _end();
+
 			while (first != last) {
-				insert_unique(end(), *first++);
+				hint = _insert_near(hint, *first++).first.node;
 			}
 		}
 
-		/*
-		iterator		insert_equal(value_type const & n);
+		// Equivalent keys are kept in insertion order, a new one goes last
+		iterator		insert_equal(value_type const & value)
+		{
+			base_pointer	x = _root();
+			base_pointer	parent = _end();
 
-		iterator		insert_equal(iterator pos, value_type const & n);
+			while (x) {
+				parent = x;
+				x = _tree.key_compare(KeyOfValue()(value), _key(x)) ? x->left : x->right;
+			}
+			return _insert(x, parent, value);
+		}
+
+		iterator		insert_equal(iterator pos, value_type const & value)
+		{
+			key_type const &	key = KeyOfValue()(value);
+
+			if ((pos == end() || !_tree.key_compare(_key(pos.node), key))
+				&& (pos == begin() || !_tree.key_compare(key, _key(node_base::decrement(pos.node)))))
+			{
+				return _insert_before(pos.node, value);
+			}
+			return insert_equal(value);
+		}
 
 		template < typename InputIterator >
 		void			insert_equal(InputIterator first, InputIterator last,
-									 typename enable_if<!is_integral<InputIterator>::value>::type * = 0);
-		*/
+									 typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			while (first != last) {
+				insert_equal(end(), *first++);
+			}
+		}
 
 		void			erase(iterator pos)
 		{
@@ -444,18 +484,27 @@ class	RedBlackTree
 			return count;
 		}
 
+		// Short ranges are erased node by node; longer ones are cut out by
+		// splitting the tree around them and joining what is left, so the
+		// rebalancing work is O(log n) whatever the length of the range
 		void			erase(iterator first, iterator last)
 		{
 			if (first == begin() && last == end()) {
 				clear();
 			}
-			else {
+			else if (_is_short_range(first, last)) {
 				while (first != last) {
 					erase(first++);
 				}
 			}
+			else {
+				_erase_range(first.node, last.node);
+			}
 		}
 
+		void			erase_below(key_type const & key)	{ erase(begin(), lower_bound(key)); }
+		void			erase_above(key_type const & key)	{ erase(upper_bound(key), end()); }
+
 		void			erase(key_type const * first, key_type const * last)
 		{
 			while (first != last) {
@@ -470,6 +519,9 @@ class	RedBlackTree
 			_root() = NULL;
 			_rightmost() = _end();
 			_tree.node_count = 0;
+# ifdef FT_RB_THREADED
+			_thread_header();
+# endif
 		}
 
 		void			swap(RedBlackTree & other)
@@ -502,7 +554,12 @@ class	RedBlackTree
 				other._root()->parent = other._end();
 			}
 			std::swap(_tree.node_count, other._tree.node_count);
+# ifdef FT_RB_THREADED
+			_thread_header();
+			other._thread_header();
+# endif
 			std::swap(_tree.key_compare, other._tree.key_compare);
+			std::swap(static_cast<node_allocator &>(_tree), static_cast<node_allocator &>(other._tree));
 		}
 
 	// Observers:
@@ -547,82 +604,498 @@ class	RedBlackTree
 
 		iterator		lower_bound(key_type const & key)
 		{
-			link_type	current = _begin();
-			link_type	last = _end();
+			return iterator(static_cast<link_type>(const_cast<base_pointer>(_lower_bound(key, _search_tag()))));
+		}
 
-			while (current) {
-				if (!_tree.key_compare(_key(current), key)) {
-					last = current;
-					current = _left(current);
+		const_iterator	lower_bound(key_type const & key) const
+		{
+			return const_iterator(static_cast<const_link_type>(_lower_bound(key, _search_tag())));
+		}
+
+		iterator		upper_bound(key_type const & key)
+		{
+			return iterator(static_cast<link_type>(const_cast<base_pointer>(_upper_bound(key, _search_tag()))));
+		}
+
+		const_iterator	upper_bound(key_type const & key) const
+		{
+			return const_iterator(static_cast<const_link_type>(_upper_bound(key, _search_tag())));
+		}
+
+		pair<iterator,iterator>
+						equal_range(key_type const & key)
+		{
+			return pair<iterator,iterator>(lower_bound(key), upper_bound(key));
+		}
+
+		pair<const_iterator, const_iterator>
+						equal_range(key_type const & key) const
+		{
+			return pair<const_iterator,const_iterator>(lower_bound(key), upper_bound(key));
+		}
+
+	// Finger search
+	// The search climbs from finger until the subtree under it spans the key,
+	// then descends that subtree only: lookups near the previous position
+	// touch the few levels around it instead of the whole height
+		iterator		finger_lower_bound(iterator finger, key_type const & key)
+		{
+			return iterator(static_cast<link_type>(const_cast<base_pointer>(
+								_finger_lower_bound(finger.node, key))));
+		}
+
+		iterator		finger_upper_bound(iterator finger, key_type const & key)
+		{
+			return iterator(static_cast<link_type>(const_cast<base_pointer>(
+								_finger_upper_bound(finger.node, key))));
+		}
+
+		iterator		finger_find(iterator finger, key_type const & key)
+		{
+			iterator	last = finger_lower_bound(finger, key);
+
+			if (last == end() || _tree.key_compare(key, _key(last.node))) {
+				return end();
+			}
+			return last;
+		}
+
+		pair<iterator, bool>
+						finger_insert_unique(iterator finger, value_type const & value)
+		{
+			iterator	pos = finger_lower_bound(finger, KeyOfValue()(value));
+
+			if (pos != end() && !_tree.key_compare(KeyOfValue()(value), _key(pos.node))) {
+				return pair<iterator, bool>(pos, false);
+			}
+			return pair<iterator, bool>(_insert_before(pos.node, value), true);
+		}
+
+		// Remembers the position of the last lookup or insert and starts the
+		// next one from there; erasing the element under the cursor
+		// invalidates it until the next reset()
+		template < typename Iter = iterator >
+		class	cursor
+		{
+			RedBlackTree *	_owner;
+			iterator		_finger;
+
+			public:
+				cursor()						: _owner(NULL), _finger()	{ }
+				explicit cursor(RedBlackTree & t)	: _owner(&t), _finger(t.end())	{ }
+
+				Iter			position() const	{ return _finger; }
+				void			reset()				{ _finger = _owner->end(); }
+				void			reset(Iter pos)		{ _finger = iterator(static_cast<link_type>(
+																const_cast<base_pointer>(pos.node))); }
+
+				Iter			lower_bound(key_type const & key)
+				{
+					return _move(_owner->finger_lower_bound(_finger, key));
 				}
-				else {
-					current = _right(current);
+
+				Iter			upper_bound(key_type const & key)
+				{
+					return _move(_owner->finger_upper_bound(_finger, key));
 				}
+
+				Iter			find(key_type const & key)
+				{
+					iterator	last = _move(_owner->finger_lower_bound(_finger, key));
+
+					if (last == _owner->end() || _owner->key_comp()(key, KeyOfValue()(*last))) {
+						return _owner->end();
+					}
+					return last;
+				}
+
+				pair<Iter, bool>	insert(value_type const & value)
+				{
+					pair<iterator, bool>	p = _owner->finger_insert_unique(_finger, value);
+
+					_finger = p.first;
+					return pair<Iter, bool>(p.first, p.second);
+				}
+
+			private:
+				iterator		_move(iterator it)
+				{
+					if (it != _owner->end()) {
+						_finger = it;
+					}
+					return it;
+				}
+		};
+
+	// Parallel bulk load and traversal
+	// Both hand their work to for_blocks(n, f, grain), which must call
+	// f(first, last) over blocks of about grain indices covering [0, n),
+	// from any threads, and return once all of them are done; parallel_map.hpp
+	// runs them on a thread_pool.
+	// values holds the addresses of count values, sorted and unique by key.
+	// The tree shape is fixed by the sorted positions alone, a perfectly
+	// balanced tree whose partial bottom level is red, so every block links
+	// its own nodes, constructing the values in place, without touching
+	// anybody else's. The nodes are allocated up front, the allocator is only
+	// called from the calling thread; value_type's copy constructor must not
+	// throw. Replaces the contents of the tree.
+		template < typename ForBlocks >
+		void			assign_sorted_unique(value_type const * const * values, size_type count,
+											 ForBlocks for_blocks)
+		{
+			_link_allocator		alloc(static_cast<node_allocator const &>(_tree));
+			link_type *			nodes = count ? alloc.allocate(count) : NULL;
+			size_type			allocated = 0;
+
+			try {
+				for (; allocated < count; allocated++) {
+					nodes[allocated] = _get_node();
+				}
+			}
+			catch (...) {
+				while (allocated) {
+					_put_node(nodes[--allocated]);
+				}
+				alloc.deallocate(nodes, count);
+				throw;
 			}
-			return iterator(last);
+			clear();
+			if (count == 0) {
+				return ;
+			}
+			// Which blocks ran is unknown if for_blocks throws: the tree stays
+			// empty and the nodes are given up
+			try {
+				for_blocks(count, _build_block(nodes, values, count, &_tree.header, get_allocator()),
+						   _bulk_grain);
+			}
+			catch (...) {
+				alloc.deallocate(nodes, count);
+				throw;
+			}
+			_root() = nodes[count / 2];
+			_leftmost() = nodes[0];
+			_rightmost() = nodes[count - 1];
+			_tree.node_count = count;
+# ifdef FT_RB_THREADED
+			_thread_header();
+# endif
+			alloc.deallocate(nodes, count);
+		}
+
+		// f is called on every element, from several threads at once, each
+		// thread going through disjoint subtrees in order; the order across
+		// subtrees is unspecified
+		template < typename ForBlocks, typename Function >
+		void			parallel_for_each(ForBlocks for_blocks, Function f)
+		{
+			_parallel_visit<value_type>(for_blocks, f);
 		}
 
-		const_iterator	lower_bound(key_type const & key) const
+		template < typename ForBlocks, typename Function >
+		void			parallel_for_each(ForBlocks for_blocks, Function f) const
 		{
-			const_link_type		current = _begin();
-			const_link_type		last = _end();
+			const_cast<RedBlackTree *>(this)->template _parallel_visit<value_type const>(for_blocks, f);
+		}
+
+	private:
+		static const size_type	_bulk_grain = 4096;
+		static const size_type	_visit_depth = 6;	// up to 64 subtrees to hand out
+		static const size_type	_max_pieces = (size_type(2) << _visit_depth) - 1;
+
+		typedef typename node_allocator::template rebind<link_type>::other	_link_allocator;
+
+		// Sorted position i holds node i; the root of positions [lo, hi) is
+		// the middle one. A block walks down to the positions it owns only
+		struct	_build_block
+		{
+			link_type const *			nodes;
+			value_type const * const *	values;
+			size_type					count;
+			size_type					red_depth;
+			base_pointer				header;
+			allocator_type				alloc;
+
+			_build_block(link_type const * nodes, value_type const * const * values,
+						 size_type count, base_pointer header, allocator_type const & alloc)
+				: nodes(nodes), values(values), count(count), red_depth(0),
+				  header(header), alloc(alloc)
+			{
+				while ((size_type(2) << red_depth) - 1 <= count) {
+					red_depth++;
+				}
+			}
+
+			void			operator () (size_type first, size_type last)
+			{
+				_link(0, count, header, 0, first, last);
+			}
+
+			base_pointer	_middle(size_type lo, size_type hi) const
+			{
+				return lo < hi ? nodes[lo + (hi - lo) / 2] : NULL;
+			}
+
+			void			_link(size_type lo, size_type hi, base_pointer parent, size_type depth,
+								  size_type first, size_type last)
+			{
+				while (lo < hi && lo < last && first < hi) {
+					size_type const	mid = lo + (hi - lo) / 2;
+					link_type const	n = nodes[mid];
+
+					if (first <= mid && mid < last) {
+						alloc.construct(&n->value, *values[mid]);
+						n->color = depth == red_depth ? red : black;
+						n->parent = parent;
+						n->left = _middle(lo, mid);
+						n->right = _middle(mid + 1, hi);
+# ifdef FT_RB_THREADED
+						n->prev = mid ? nodes[mid - 1] : header;
+						n->next = mid + 1 < count ? nodes[mid + 1] : header;
+# endif
+					}
+					_link(lo, mid, n, depth + 1, first, last);
+					parent = n;
+					lo = mid + 1;
+					depth++;
+				}
+			}
+		};
+
+		// A piece is a whole subtree, or one node above them, in order
+		struct	_piece
+		{
+			base_pointer	node;
+			bool			whole;
+		};
+
+		template < typename V, typename Function >
+		struct	_visit_block
+		{
+			_piece const *	pieces;
+			Function		f;
+
+			_visit_block(_piece const * pieces, Function const & f) : pieces(pieces), f(f)	{ }
+
+			void	operator () (size_type first, size_type last)
+			{
+				for (; first < last; first++) {
+					if (pieces[first].whole) {
+						_visit(pieces[first].node);
+					}
+					else {
+						f(static_cast<V &>(static_cast<link_type>(pieces[first].node)->value));
+					}
+				}
+			}
+
+			void	_visit(base_pointer n)
+			{
+				while (n) {
+					_visit(n->left);
+					f(static_cast<V &>(static_cast<link_type>(n)->value));
+					n = n->right;
+				}
+			}
+		};
+
+		// At most 2^_visit_depth whole subtrees and the nodes above them
+		static void		_cut(base_pointer n, size_type depth, _piece * pieces, size_type & count)
+		{
+			while (n) {
+				_piece	p = { n, depth == _visit_depth };
+
+				if (p.whole) {
+					pieces[count++] = p;
+					return ;
+				}
+				_cut(n->left, depth + 1, pieces, count);
+				pieces[count++] = p;
+				n = n->right;
+				depth++;
+			}
+		}
+
+		template < typename V, typename ForBlocks, typename Function >
+		void			_parallel_visit(ForBlocks & for_blocks, Function const & f)
+		{
+			_piece		pieces[_max_pieces];
+			size_type	count = 0;
+
+			_cut(_root(), 0, pieces, count);
+			if (count) {
+				for_blocks(count, _visit_block<V, Function>(pieces, f), 1);
+			}
+		}
+
+	// Search
+	protected:
+		// ft::less on an arithmetic key compares with a single instruction,
+		// so the descent can select the child without a branch
+		typedef integral_constant<bool, is_same< Compare, less<Key> >::value
+										&& is_arithmetic<Key>::value>	_search_tag;
+
+		const_base_pointer	_lower_bound(key_type const & key, false_type) const
+		{
+			const_base_pointer	current = _tree.header.parent;
+			const_base_pointer	last = &_tree.header;
 
 			while (current) {
 				if (!_tree.key_compare(_key(current), key)) {
 					last = current;
-					current = _left(current);
+					current = current->left;
 				}
 				else {
-					current = _right(current);
+					current = current->right;
 				}
 			}
-			return const_iterator(last);
+			return last;
 		}
 
-		iterator		upper_bound(key_type const & key)
+		const_base_pointer	_upper_bound(key_type const & key, false_type) const
 		{
-			link_type	current = _begin();
-			link_type	last = _end();
+			const_base_pointer	current = _tree.header.parent;
+			const_base_pointer	last = &_tree.header;
 
 			while (current) {
 				if (_tree.key_compare(key, _key(current))) {
 					last = current;
-					current = _left(current);
+					current = current->left;
 				}
 				else {
-					current = _right(current);
+					current = current->right;
 				}
 			}
-			return iterator(last);
+			return last;
 		}
 
-		const_iterator	upper_bound(key_type const & key) const
+		// Both children are prefetched before the compare resolves, the
+		// selects compile to conditional moves; only the loop exit branches
+		const_base_pointer	_lower_bound(key_type const & key, true_type) const
 		{
-			const_link_type		current = _begin();
-			const_link_type		last = _end();
+			const_base_pointer	current = _tree.header.parent;
+			const_base_pointer	last = &_tree.header;
 
 			while (current) {
-				if (_tree.key_compare(key, _key(current))) {
-					last = current;
-					current = _left(current);
+				_prefetch(current->left);
+				_prefetch(current->right);
+
+				bool const	go_right = _key(current) < key;
+
+				last = go_right ? last : current;
+				current = go_right ? current->right : current->left;
+			}
+			return last;
+		}
+
+		const_base_pointer	_upper_bound(key_type const & key, true_type) const
+		{
+			const_base_pointer	current = _tree.header.parent;
+			const_base_pointer	last = &_tree.header;
+
+			while (current) {
+				_prefetch(current->left);
+				_prefetch(current->right);
+
+				bool const	go_left = key < _key(current);
+
+				last = go_left ? current : last;
+				current = go_left ? current->left : current->right;
+			}
+			return last;
+		}
+
+		// lower_bound is in finger's subtree after the climb, or is the
+		// ancestor the climb stopped under (the header past the root)
+		const_base_pointer	_finger_lower_bound(const_base_pointer finger, key_type const & key) const
+		{
+			const_base_pointer	x = finger;
+			const_base_pointer	last = &_tree.header;
+
+			if (finger == &_tree.header || !_root()) {
+				return _lower_bound(key, _search_tag());
+			}
+			if (_tree.key_compare(_key(finger), key)) {
+				while (x != _root()) {
+					const_base_pointer	p = x->parent;
+
+					if (x == p->left && !_tree.key_compare(_key(p), key)) {
+						last = p;
+						break;
+					}
+					x = p;
+				}
+			}
+			else {
+				while (x != _root()) {
+					const_base_pointer	p = x->parent;
+
+					if (x == p->right && _tree.key_compare(_key(p), key)) {
+						break;
+					}
+					x = p;
+				}
+			}
+			while (x) {
+				if (!_tree.key_compare(_key(x), key)) {
+					last = x;
+					x = x->left;
 				}
 				else {
-					current = _right(current);
+					x = x->right;
 				}
 			}
-			return const_iterator(last);
+			return last;
 		}
 
-		pair<iterator,iterator>
-						equal_range(key_type const & key)
+		const_base_pointer	_finger_upper_bound(const_base_pointer finger, key_type const & key) const
 		{
-			return pair<iterator,iterator>(lower_bound(key), upper_bound(key));
+			const_base_pointer	x = finger;
+			const_base_pointer	last = &_tree.header;
+
+			if (finger == &_tree.header || !_root()) {
+				return _upper_bound(key, _search_tag());
+			}
+			if (!_tree.key_compare(key, _key(finger))) {
+				while (x != _root()) {
+					const_base_pointer	p = x->parent;
+
+					if (x == p->left && _tree.key_compare(key, _key(p))) {
+						last = p;
+						break;
+					}
+					x = p;
+				}
+			}
+			else {
+				while (x != _root()) {
+					const_base_pointer	p = x->parent;
+
+					if (x == p->right && !_tree.key_compare(key, _key(p))) {
+						break;
+					}
+					x = p;
+				}
+			}
+			while (x) {
+				if (_tree.key_compare(key, _key(x))) {
+					last = x;
+					x = x->left;
+				}
+				else {
+					x = x->right;
+				}
+			}
+			return last;
 		}
 
-		pair<const_iterator, const_iterator>
-						equal_range(key_type const & key) const
+		static void		_prefetch(const_base_pointer n)
 		{
-			return pair<const_iterator,const_iterator>(lower_bound(key), upper_bound(key));
+# if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(n);
+# else
+			(void)n;
+# endif
 		}
 
 	protected:
@@ -767,11 +1240,62 @@ class	RedBlackTree
 				}
 			}
 
+# ifdef FT_RB_THREADED
+			node_base::link_after(insert_left ? parent->prev : parent, new_node);
+# endif
 			_rebalance_after_insert(new_node);
 			_tree.node_count++;
 			return iterator(new_node);
 		}
 
+		pair<iterator, bool>
+						_insert_near(base_pointer hint, value_type const & value)
+		{
+			key_type const &	key = KeyOfValue()(value);
+
+			if (!_root()) {
+				return pair<iterator, bool>(_insert(0, _end(), value), true);
+			}
+			if (_tree.key_compare(_key(_rightmost()), key)) {
+				return pair<iterator, bool>(_insert(0, _rightmost(), value), true);
+			}
+			if (_tree.key_compare(key, _key(_leftmost()))) {
+				return pair<iterator, bool>(_insert(_leftmost(), _leftmost(), value), true);
+			}
+			if (hint != &_tree.header) {
+				if (_tree.key_compare(_key(hint), key)) {
+					base_pointer	next = node_base::increment(hint);
+
+					if (_tree.key_compare(key, _key(next))) {
+						return pair<iterator, bool>(_insert_before(next, value), true);
+					}
+				}
+				else if (_tree.key_compare(key, _key(hint))) {
+					base_pointer	prev = node_base::decrement(hint);
+
+					if (_tree.key_compare(_key(prev), key)) {
+						return pair<iterator, bool>(_insert_before(hint, value), true);
+					}
+				}
+				else {
+					return pair<iterator, bool>(iterator(static_cast<link_type>(hint)), false);
+				}
+			}
+			return finger_insert_unique(iterator(static_cast<link_type>(hint)), value);
+		}
+
+		// Links value in as the in-order predecessor of pos (end() appends)
+		iterator		_insert_before(base_pointer pos, value_type const & value)
+		{
+			if (pos == &_tree.header) {
+				return _insert(0, _root() ? _rightmost() : pos, value);
+			}
+			if (!pos->left) {
+				return _insert(pos, pos, value);
+			}
+			return _insert(0, node_base::maximum(pos->left), value);
+		}
+
 		link_type		_copy(const_link_type n, link_type p)
 		{
 			link_type	top = _clone_node(n);
@@ -811,7 +1335,8 @@ class	RedBlackTree
 			}
 		}
 
-		void			_rebalance_after_insert(base_pointer node)
+		// Returns whether the black height of the tree grew
+		bool			_rebalance_after_insert(base_pointer node)
 		{
 			base_pointer &	root = _tree.header.parent;
 
@@ -854,7 +1379,222 @@ class	RedBlackTree
 					}
 				}
 			}
+			bool const	grew = root->color == red;
+
 			root->color = black;
+			return grew;
+		}
+
+# ifdef FT_RB_THREADED
+		// Rebuilds the in-order ring after whole subtrees were copied
+		void			_thread_all()
+		{
+			base_pointer	last = &_tree.header;
+
+			_thread_subtree(_root(), last);
+			last->next = &_tree.header;
+			_tree.header.prev = last;
+		}
+
+		static void		_thread_subtree(base_pointer n, base_pointer & last)
+		{
+			while (n) {
+				_thread_subtree(n->left, last);
+				last->next = n;
+				n->prev = last;
+				last = n;
+				n = n->right;
+			}
+		}
+
+		// Points the header at the ends of the tree it now holds
+		void			_thread_header()
+		{
+			if (_root()) {
+				_tree.header.next = _leftmost();
+				_tree.header.prev = _rightmost();
+				_leftmost()->prev = &_tree.header;
+				_rightmost()->next = &_tree.header;
+			}
+			else {
+				_tree.header.next = &_tree.header;
+				_tree.header.prev = &_tree.header;
+			}
+		}
+
+# endif
+
+	// Split and join
+	// Subtrees are passed around with their black height (black nodes from
+	// the root, included, down to a leaf) so no join has to measure it.
+	// The header is used as scratch space: the tree being split is already
+	// detached from it, and rotations need a root slot to update.
+		static const size_type	_erase_range_threshold = 16;
+
+		static bool		_is_short_range(iterator first, iterator last)
+		{
+			for (size_type n = 0; n < _erase_range_threshold; n++) {
+				if (first == last) {
+					return true;
+				}
+				++first;
+			}
+			return first == last;
+		}
+
+		void			_erase_range(base_pointer first, base_pointer last)
+		{
+			base_pointer	left;
+			base_pointer	mid;
+			base_pointer	right;
+			size_type		left_height;
+			size_type		mid_height;
+			size_type		right_height;
+			size_type		count = ft::distance(iterator(static_cast<link_type>(first)),
+												 iterator(static_cast<link_type>(last)));
+
+# ifdef FT_RB_THREADED
+			first->prev->next = last;
+			last->prev = first->prev;
+# endif
+			_split_at(first, _black_height(_root()), left, left_height, mid, mid_height);
+			_destroy_node(static_cast<link_type>(first));
+			if (last != &_tree.header) {
+				_root() = mid;
+				mid->parent = &_tree.header;
+				_split_at(last, mid_height, mid, mid_height, right, right_height);
+				left = _join(left, left_height, last, right, right_height, left_height);
+			}
+			_erase(static_cast<link_type>(mid));
+
+			_root() = left;
+			if (left) {
+				left->parent = &_tree.header;
+				left->color = black;
+				_leftmost() = node_base::minimum(left);
+				_rightmost() = node_base::maximum(left);
+			}
+			else {
+				_leftmost() = &_tree.header;
+				_rightmost() = &_tree.header;
+			}
+			_tree.node_count -= count;
+		}
+
+		static size_type	_black_height(const_base_pointer n)
+		{
+			size_type	h = 0;
+
+			for (; n; n = n->left) {
+				h += n->color == black;
+			}
+			return h;
+		}
+
+		// Splits the tree under the header, of black height h, into the nodes
+		// before x and the nodes after it, x itself being detached. Works
+		// bottom-up from x by position, so equivalent keys split correctly:
+		// every ancestor joins the side x is not on, together with its
+		// other subtree
+		void			_split_at(base_pointer x, size_type h,
+								  base_pointer & left, size_type & left_height,
+								  base_pointer & right, size_type & right_height)
+		{
+			base_pointer	path[2 * sizeof(size_type) * 8];
+			size_type		heights[2 * sizeof(size_type) * 8];
+			size_type		depth = 0;
+
+			for (base_pointer p = x; p != &_tree.header; p = p->parent) {
+				path[depth++] = p;
+			}
+			heights[depth - 1] = h;
+			for (size_type i = depth - 1; i > 0; i--) {
+				heights[i - 1] = heights[i] - (path[i]->color == black);
+			}
+
+			left = x->left;
+			right = x->right;
+			left_height = heights[0] - (x->color == black);
+			right_height = left_height;
+			for (size_type i = 1; i < depth; i++) {
+				base_pointer const	p = path[i];
+				base_pointer const	p_left = p->left;
+				base_pointer const	p_right = p->right;
+				size_type const		child_height = heights[i] - (p->color == black);
+
+				if (path[i - 1] == p_right) {
+					left = _join(p_left, child_height, p, left, left_height, left_height);
+				}
+				else {
+					right = _join(right, right_height, p, p_right, child_height, right_height);
+				}
+			}
+		}
+
+		// Joins a < k < b into one subtree with a black root and returns it;
+		// k is hung at the level of the shorter side on the spine of the
+		// taller one and the red-red conflict, if any, fixed as an insert
+		base_pointer	_join(base_pointer a, size_type a_height, base_pointer k,
+							  base_pointer b, size_type b_height, size_type & height)
+		{
+			if (a && a->color == red) {
+				a->color = black;
+				a_height++;
+			}
+			if (b && b->color == red) {
+				b->color = black;
+				b_height++;
+			}
+			if (a_height == b_height) {
+				k->left = a;
+				k->right = b;
+				k->color = black;
+				if (a) {
+					a->parent = k;
+				}
+				if (b) {
+					b->parent = k;
+				}
+				height = a_height + 1;
+				return k;
+			}
+
+			bool const		left_taller = a_height > b_height;
+			base_pointer	x = left_taller ? a : b;
+			base_pointer	p = NULL;
+			size_type		h = left_taller ? a_height : b_height;
+			size_type const	target = left_taller ? b_height : a_height;
+
+			_root() = x;
+			x->parent = &_tree.header;
+			while (x && !(x->color == black && h == target)) {
+				h -= x->color == black;
+				p = x;
+				x = left_taller ? x->right : x->left;
+			}
+			k->color = red;
+			k->parent = p;
+			if (left_taller) {
+				p->right = k;
+				k->left = x;
+				k->right = b;
+				if (b) {
+					b->parent = k;
+				}
+			}
+			else {
+				p->left = k;
+				k->left = a;
+				k->right = x;
+				if (a) {
+					a->parent = k;
+				}
+			}
+			if (x) {
+				x->parent = k;
+			}
+			height = (left_taller ? a_height : b_height) + _rebalance_after_insert(k);
+			return _root();
 		}
 
 		base_pointer		_erase_node(base_pointer const & node)
@@ -863,6 +1603,10 @@ class	RedBlackTree
 			base_pointer		x = NULL;
 			base_pointer		x_parent = NULL;
 
+# ifdef FT_RB_THREADED
+			node_base::unlink(node);
+# endif
+
 			if (!y->left) {
 				x = y->right; }
 			else {
@@ -0,0 +1,105 @@
+#ifndef FT_ATOMIC_HPP
+# define FT_ATOMIC_HPP
+
+# include <cstddef>
+
+namespace	ft
+
+{
+
+// Thin wrappers over the GCC/Clang __atomic builtins, which are available
+// in every language mode; the concurrent containers share them so the
+// memory ordering of each access is spelled out where it is used
+
+enum	memory_order
+{
+	memory_order_relaxed = __ATOMIC_RELAXED,
+	memory_order_acquire = __ATOMIC_ACQUIRE,
+	memory_order_release = __ATOMIC_RELEASE,
+	memory_order_acq_rel = __ATOMIC_ACQ_REL,
+	memory_order_seq_cst = __ATOMIC_SEQ_CST
+};
+
+static const size_t		cache_line_size = 64;
+
+template < class T >
+inline T	atomic_load(T const volatile * p, memory_order order = memory_order_seq_cst)
+{
+	return __atomic_load_n(p, order);
+}
+
+template < class T >
+inline void	atomic_store(T volatile * p, T value, memory_order order = memory_order_seq_cst)
+{
+	__atomic_store_n(p, value, order);
+}
+
+template < class T >
+inline T	atomic_exchange(T volatile * p, T value, memory_order order = memory_order_seq_cst)
+{
+	return __atomic_exchange_n(p, value, order);
+}
+
+// On failure expected is updated with the value found
+template < class T >
+inline bool	atomic_compare_exchange(T volatile * p, T & expected, T desired,
+									memory_order order = memory_order_seq_cst)
+{
+	return __atomic_compare_exchange_n(p, &expected, desired, false, order,
+									   order == memory_order_release ? memory_order_relaxed
+									   : order == memory_order_acq_rel ? memory_order_acquire
+									   : order);
+}
+
+template < class T >
+inline T	atomic_fetch_add(T volatile * p, T value, memory_order order = memory_order_seq_cst)
+{
+	return __atomic_fetch_add(p, value, order);
+}
+
+template < class T >
+inline T	atomic_fetch_sub(T volatile * p, T value, memory_order order = memory_order_seq_cst)
+{
+	return __atomic_fetch_sub(p, value, order);
+}
+
+inline void	atomic_thread_fence(memory_order order = memory_order_seq_cst)
+{
+	__atomic_thread_fence(order);
+}
+
+// Spin-wait hint, lets the sibling hyper-thread run
+inline void	cpu_relax()
+{
+# if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+# elif defined(__aarch64__)
+	__asm__ __volatile__("yield");
+# endif
+}
+
+// A value alone on its cache line(s): written by one thread, it does not
+// invalidate the lines its neighbours are read or written through
+template < class T >
+struct	padded
+{
+	T		value;
+	char	_pad[cache_line_size - sizeof(T) % cache_line_size];
+};
+
+// Small dense id of the calling thread, handed out on first use; used to
+// spread threads over per-thread slots without hashing pthread_t
+inline size_t	this_thread_index()
+{
+	static size_t			next = 0;
+	static __thread size_t	index = 0;
+
+	if (index == 0) {
+		index = atomic_fetch_add(&next, size_t(1)) + 1;
+	}
+	return index - 1;
+}
+
+}
+
+#endif
@@ -0,0 +1,591 @@
+#ifndef FT_CONCURRENT_MAP_HPP
+# define FT_CONCURRENT_MAP_HPP
+
+# include <memory>
+
+# include "atomic.hpp"
+# include "mutex.hpp"
+# include "vector.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+// Read-mostly ordered map shared between threads
+//
+// Readers never lock and never write shared memory besides their own
+// epoch slot: they pin the current epoch, load the root and walk a tree
+// that no one modifies any more. Writers serialize on one mutex and never
+// touch a published node either: every node on the path an update changes
+// is copied, the new root is published with a single release store and the
+// replaced nodes are retired. A retired node is freed once every reader that
+// could still reach it, one that pinned an epoch not later than the one it
+// was retired in, has left.
+//
+// The tree is red-black like ft::map's, but without parent pointers, which
+// would make every copy-on-write path the whole tree. Updates are expressed
+// with split and join, as RedBlackTree's range erase, so only the nodes
+// along a search path or two are copied.
+template	<	class Key,
+				class T,
+				class Compare = less<Key>,
+				class Allocator = std::allocator< pair<Key const, T> >
+			>
+class	concurrent_map
+{
+	// Type definitions
+	public:
+		typedef Key											key_type;
+		typedef T											mapped_type;
+		typedef pair<key_type const, mapped_type>			value_type;
+		typedef Compare										key_compare;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::const_reference	const_reference;
+		typedef typename allocator_type::const_pointer		const_pointer;
+		typedef typename allocator_type::size_type			size_type;
+		typedef typename allocator_type::difference_type	difference_type;
+
+	// Private members
+	private:
+		struct	node
+		{
+			node *		left;
+			node *		right;
+			size_type	version;	// write that created it, the only one that may change it
+			size_type	height;		// black nodes on a path down to a leaf, itself included
+			bool		red;
+			value_type	value;
+		};
+
+		typedef typename Allocator::template rebind<node>::other	node_allocator;
+
+		struct	retired
+		{
+			node *		n;
+			size_type	epoch;
+		};
+
+		// Readers pin their epoch in one of these, 0 when free; a thread
+		// starts looking at its own index so slots are rarely contended
+		static const size_type	_slot_count = 128;
+		static const size_type	_reclaim_threshold = 256;
+
+		// Read by every reader, written once per update
+		struct	shared_state
+		{
+			node *		root;
+			size_type	epoch;
+			size_type	size;
+		};
+
+		padded<shared_state>			_shared;
+		mutable padded<size_type>		_slots[_slot_count];
+
+		mutex							_writer;
+		size_type						_version;
+		ft::vector<retired>				_retired;
+		key_compare						_comp;
+		allocator_type					_alloc;
+		node_allocator					_node_alloc;
+
+	// Snapshot
+	// Pins the tree as it is when constructed: lookups and walks through it
+	// see no later update, and nothing it can reach is freed until it is
+	// destroyed. Keep snapshots short-lived, they hold back reclamation
+	public:
+		class	snapshot
+		{
+			concurrent_map const &	_map;
+			size_type				_slot;
+			node const *			_root;
+
+			snapshot(snapshot const &);
+			snapshot &	operator = (snapshot const &);
+
+			public:
+				explicit snapshot(concurrent_map const & map)
+					: _map(map), _slot(map._enter())
+				{
+					_root = atomic_load(&_map._shared.value.root, memory_order_acquire);
+				}
+
+				~snapshot()
+				{
+					_map._leave(_slot);
+				}
+
+				bool			empty() const		{ return _root == NULL; }
+
+				// NULL when key is absent
+				const_pointer	find(key_type const & key) const
+				{
+					node const *	n = _root;
+
+					while (n) {
+						if (_map._comp(key, n->value.first))
+							n = n->left;
+						else if (_map._comp(n->value.first, key))
+							n = n->right;
+						else
+							return &n->value;
+					}
+					return NULL;
+				}
+
+				// Calls f on every value in key order
+				template < class Function >
+				Function		for_each(Function f) const
+				{
+					return _for_each(_root, f);
+				}
+
+			private:
+				template < class Function >
+				static Function	_for_each(node const * n, Function f)
+				{
+					while (n) {
+						f = _for_each(n->left, f);
+						f(n->value);
+						n = n->right;
+					}
+					return f;
+				}
+		};
+
+	// Constructors
+	public:
+		explicit concurrent_map (key_compare const & comp = key_compare(),
+								 allocator_type const & alloc = allocator_type())
+			: _version(0), _comp(comp), _alloc(alloc), _node_alloc(alloc)
+		{
+			_shared.value.root = NULL;
+			_shared.value.epoch = 1;
+			_shared.value.size = 0;
+			for (size_type i = 0; i < _slot_count; i++) {
+				_slots[i].value = 0;
+			}
+		}
+
+		// No reader may be running
+		~concurrent_map()
+		{
+			_destroy(_shared.value.root);
+			for (size_type i = 0; i < _retired.size(); i++) {
+				_destroy_node(_retired[i].n);
+			}
+		}
+
+	// Capacity
+		bool			empty() const	{ return size() == 0; }
+		size_type		size() const	{ return atomic_load(&_shared.value.size, memory_order_relaxed); }
+
+	// Lookup, lock-free
+		bool			find(key_type const & key, mapped_type & value) const
+		{
+			snapshot		s(*this);
+			const_pointer	p = s.find(key);
+
+			if (p) {
+				value = p->second;
+			}
+			return p != NULL;
+		}
+
+		size_type		count(key_type const & key) const
+		{
+			return snapshot(*this).find(key) ? 1 : 0;
+		}
+
+	// Modifiers, serialized
+		// False, and the map unchanged, when the key is already there
+		bool			insert(value_type const & value)
+		{
+			lock_guard<mutex>	guard(_writer);
+
+			if (_find(value.first)) {
+				return false;
+			}
+			_update(value);
+			return true;
+		}
+
+		// True when the key was inserted, false when it was assigned
+		bool			insert_or_assign(key_type const & key, mapped_type const & obj)
+		{
+			lock_guard<mutex>	guard(_writer);
+			bool const			inserted = _find(key) == NULL;
+
+			_update(value_type(key, obj));
+			return inserted;
+		}
+
+		size_type		erase(key_type const & key)
+		{
+			lock_guard<mutex>	guard(_writer);
+
+			if (!_find(key)) {
+				return 0;
+			}
+
+			size_type const	mark = _begin_update();
+			node *			left;
+			node *			right;
+
+			try {
+				node *	n = _split(_shared.value.root, key, left, right);
+
+				_retire(n);
+				_publish(_join2(left, right), _shared.value.size - 1);
+			}
+			catch (...) {
+				_retired.erase(_retired.begin() + mark, _retired.end());
+				throw;
+			}
+			return 1;
+		}
+
+		void			clear()
+		{
+			lock_guard<mutex>	guard(_writer);
+
+			_begin_update();
+			_retire_all(_shared.value.root);
+			_publish(NULL, 0);
+		}
+
+	// Observers
+		key_compare		key_comp() const		{ return _comp; }
+		allocator_type	get_allocator() const	{ return _alloc; }
+
+	// Private member functions
+	private:
+		concurrent_map (concurrent_map const &);
+		concurrent_map &	operator = (concurrent_map const &);
+
+		// Epochs
+		// The seq_cst exchange and fence order the slot store before the
+		// root load, against _publish's epoch bump before its slot scan:
+		// either the writer sees this reader, or the reader sees the new root
+		size_type		_enter() const
+		{
+			size_type	i = this_thread_index();
+
+			for (;; i++) {
+				size_type &	slot = _slots[i % _slot_count].value;
+				size_type	expected = 0;
+
+				if (atomic_load(&slot, memory_order_relaxed) == 0
+					&& atomic_compare_exchange(&slot, expected,
+							atomic_load(&_shared.value.epoch, memory_order_acquire))) {
+					atomic_thread_fence();
+					return i % _slot_count;
+				}
+				if (i % _slot_count == _slot_count - 1) {
+					cpu_relax();
+				}
+			}
+		}
+
+		void			_leave(size_type slot) const
+		{
+			atomic_store(&_slots[slot].value, size_type(0), memory_order_release);
+		}
+
+		// Opens a write: nodes created from now on belong to it and may be
+		// changed in place. Returns the retire mark to roll back to
+		size_type		_begin_update()
+		{
+			_version++;
+			return _retired.size();
+		}
+
+		void			_publish(node * root, size_type size)
+		{
+			atomic_store(&_shared.value.root, root, memory_order_release);
+			atomic_store(&_shared.value.size, size, memory_order_relaxed);
+			atomic_fetch_add(&_shared.value.epoch, size_type(1));
+			if (_retired.size() >= _reclaim_threshold) {
+				_reclaim();
+			}
+		}
+
+		// Frees, oldest first, the retired nodes no pinned reader can reach
+		void			_reclaim()
+		{
+			size_type	oldest = size_type(-1);
+			size_type	freed = 0;
+
+			atomic_thread_fence();
+			for (size_type i = 0; i < _slot_count; i++) {
+				size_type const	e = atomic_load(&_slots[i].value, memory_order_acquire);
+
+				if (e && e < oldest) {
+					oldest = e;
+				}
+			}
+			while (freed < _retired.size() && _retired[freed].epoch < oldest) {
+				_destroy_node(_retired[freed++].n);
+			}
+			_retired.erase(_retired.begin(), _retired.begin() + freed);
+		}
+
+		void			_retire(node * n)
+		{
+			retired	r;
+
+			r.n = n;
+			r.epoch = _shared.value.epoch;
+			_retired.push_back(r);
+		}
+
+		void			_retire_all(node * n)
+		{
+			while (n) {
+				_retire_all(n->left);
+				_retire(n);
+				n = n->right;
+			}
+		}
+
+		// Nodes
+		node *			_create_node(value_type const & value)
+		{
+			node *	n = _node_alloc.allocate(1);
+
+			try {
+				_alloc.construct(&n->value, value);
+			}
+			catch (...) {
+				_node_alloc.deallocate(n, 1);
+				throw;
+			}
+			n->left = NULL;
+			n->right = NULL;
+			n->version = _version;
+			n->height = 1;
+			n->red = false;
+			return n;
+		}
+
+		void			_destroy_node(node * n)
+		{
+			_alloc.destroy(&n->value);
+			_node_alloc.deallocate(n, 1);
+		}
+
+		void			_destroy(node * n)
+		{
+			while (n) {
+				node *	right = n->right;
+
+				_destroy(n->left);
+				_destroy_node(n);
+				n = right;
+			}
+		}
+
+		// n itself when this write created it, otherwise a copy, n being
+		// retired: a published node is never written to
+		node *			_own(node * n)
+		{
+			if (n->version == _version) {
+				return n;
+			}
+
+			node *	copy = _create_node(n->value);
+
+			copy->left = n->left;
+			copy->right = n->right;
+			copy->height = n->height;
+			copy->red = n->red;
+			_retire(n);
+			return copy;
+		}
+
+		static size_type	_height(node const * n)		{ return n ? n->height : 0; }
+		static bool			_is_red(node const * n)		{ return n && n->red; }
+
+		node const *	_find(key_type const & key) const
+		{
+			node const *	n = _shared.value.root;
+
+			while (n) {
+				if (_comp(key, n->value.first))
+					n = n->left;
+				else if (_comp(n->value.first, key))
+					n = n->right;
+				else
+					return n;
+			}
+			return NULL;
+		}
+
+		// Inserts value, replacing the node of an equal key
+		void			_update(value_type const & value)
+		{
+			size_type const	mark = _begin_update();
+			size_type		size = _shared.value.size;
+			node *			n = _create_node(value);
+			node *			left;
+			node *			right;
+
+			try {
+				node *	old = _split(_shared.value.root, value.first, left, right);
+
+				if (old) {
+					_retire(old);
+					size--;
+				}
+				_publish(_join(left, n, right), size + 1);
+			}
+			catch (...) {
+				_retired.erase(_retired.begin() + mark, _retired.end());
+				_destroy_node(n);
+				throw;
+			}
+		}
+
+		// Splits t into the keys less than key and the keys greater than it;
+		// returns the node of key itself, left untouched, or NULL
+		node *			_split(node * t, key_type const & key, node *& left, node *& right)
+		{
+			node *	m;
+			node *	sub;
+
+			if (!t) {
+				left = NULL;
+				right = NULL;
+				return NULL;
+			}
+			if (_comp(key, t->value.first)) {
+				node *	r = t->right;
+
+				m = _split(t->left, key, left, sub);
+				right = _join(sub, _own(t), r);
+			}
+			else if (_comp(t->value.first, key)) {
+				node *	l = t->left;
+
+				m = _split(t->right, key, sub, right);
+				left = _join(l, _own(t), sub);
+			}
+			else {
+				left = t->left;
+				right = t->right;
+				m = t;
+			}
+			return m;
+		}
+
+		// Joins a < k < b; k must belong to this write
+		node *			_join(node * a, node * k, node * b)
+		{
+			node *	t;
+
+			if (_is_red(a)) {
+				a = _own(a);
+				a->red = false;
+				a->height++;
+			}
+			if (_is_red(b)) {
+				b = _own(b);
+				b->red = false;
+				b->height++;
+			}
+			if (_height(a) == _height(b)) {
+				k->left = a;
+				k->right = b;
+				k->red = false;
+				k->height = _height(a) + 1;
+				return k;
+			}
+			if (_height(a) > _height(b)) {
+				t = _join_right(a, k, b);
+				if (t->red && _is_red(t->right)) {
+					t->red = false;
+					t->height++;
+				}
+			}
+			else {
+				t = _join_left(a, k, b);
+				if (t->red && _is_red(t->left)) {
+					t->red = false;
+					t->height++;
+				}
+			}
+			return t;
+		}
+
+		// Hangs k, red, on the right spine of t at b's black height; a
+		// red-red pair is rotated away at the first black node above it
+		node *			_join_right(node * t, node * k, node * b)
+		{
+			if (!_is_red(t) && _height(t) == _height(b)) {
+				k->left = t;
+				k->right = b;
+				k->red = true;
+				k->height = _height(b);
+				return k;
+			}
+			t = _own(t);
+			t->right = _join_right(t->right, k, b);
+			if (!t->red && t->right->red && _is_red(t->right->right)) {
+				node *	r = t->right;
+
+				r->right->red = false;
+				r->right->height++;
+				t->right = r->left;
+				r->left = t;
+				r->height = t->height;
+				return r;
+			}
+			return t;
+		}
+
+		node *			_join_left(node * a, node * k, node * t)
+		{
+			if (!_is_red(t) && _height(t) == _height(a)) {
+				k->left = a;
+				k->right = t;
+				k->red = true;
+				k->height = _height(a);
+				return k;
+			}
+			t = _own(t);
+			t->left = _join_left(a, k, t->left);
+			if (!t->red && t->left->red && _is_red(t->left->left)) {
+				node *	l = t->left;
+
+				l->left->red = false;
+				l->left->height++;
+				t->left = l->right;
+				l->right = t;
+				l->height = t->height;
+				return l;
+			}
+			return t;
+		}
+
+		// Joins a < b, the maximum of a becoming the pivot
+		node *			_join2(node * a, node * b)
+		{
+			node *	last = a;
+			node *	left;
+			node *	right;
+
+			if (!a) {
+				return b;
+			}
+			while (last->right) {
+				last = last->right;
+			}
+			last = _split(a, last->value.first, left, right);
+			return _join(left, _own(last), b);
+		}
+
+};
+
+}
+
+#endif
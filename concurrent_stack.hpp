@@ -0,0 +1,385 @@
+#ifndef FT_CONCURRENT_STACK_HPP
+# define FT_CONCURRENT_STACK_HPP
+
+# include <memory>
+
+# include "atomic.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+// Lock-free LIFO shared between threads (Treiber stack)
+//
+// The top of the stack is one word holding a node pointer in its low bits
+// and a tag in the rest, bumped by every successful exchange, so a pop
+// whose top was popped and pushed back in between fails its compare and
+// exchange instead of linking a stale next (ABA). Nodes are recycled
+// through a free list of the same kind and only freed with the stack, so
+// a late reader of a node's next pointer always reads a node.
+//
+// When the top is contended, a failed push offers its node in a small
+// elimination array and a failed pop looks there: a push and a pop that
+// meet cancel out without touching the top at all. Otherwise they back
+// off exponentially before retrying.
+//
+// Pointers are assumed to fit in 48 bits, as user-space addresses do on
+// x86-64 and AArch64 with default page tables.
+template < class T, class Allocator = std::allocator<T> >
+class	concurrent_stack
+{
+	// Type definitions
+	public:
+		typedef T											value_type;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::size_type			size_type;
+		typedef value_type &								reference;
+		typedef value_type const &							const_reference;
+
+	// Private members
+	private:
+		struct	node
+		{
+			node *						next;
+			aligned_buffer<T, 1>		storage;
+		};
+
+		typedef typename Allocator::template rebind<node>::other	node_allocator;
+		typedef unsigned long long									word;
+
+		static const unsigned	_pointer_bits = sizeof(void *) == 8 ? 48 : 32;
+		static const word		_pointer_mask = (word(1) << _pointer_bits) - 1;
+		static const size_type	_elimination_slots = 16;
+		static const unsigned	_elimination_spins = 128;
+		static const unsigned	_max_backoff = 1024;
+
+		padded<word>				_top;
+		padded<word>				_free;
+		padded<word>				_slots[_elimination_slots];
+		allocator_type				_alloc;
+		node_allocator				_node_alloc;
+
+	// Constructors
+	public:
+		explicit concurrent_stack (allocator_type const & alloc = allocator_type())
+			: _alloc(alloc), _node_alloc(alloc)
+		{
+			_top.value = 0;
+			_free.value = 0;
+			for (size_type i = 0; i < _elimination_slots; i++) {
+				_slots[i].value = 0;
+			}
+		}
+
+		// No other thread may be using the stack
+		~concurrent_stack()
+		{
+			node *	n = _ptr(_top.value);
+
+			while (n) {
+				node *	next = n->next;
+
+				_alloc.destroy(n->storage.ptr());
+				_node_alloc.deallocate(n, 1);
+				n = next;
+			}
+			for (n = _ptr(_free.value); n; ) {
+				node *	next = n->next;
+
+				_node_alloc.deallocate(n, 1);
+				n = next;
+			}
+		}
+
+	// Capacity
+		// Only a hint while other threads push and pop
+		bool			empty() const
+		{
+			return _ptr(atomic_load(&_top.value, memory_order_relaxed)) == NULL;
+		}
+
+	// Modifiers
+		void			push(value_type const & value)
+		{
+			node *	n = _acquire();
+
+			try {
+				_alloc.construct(n->storage.ptr(), value);
+			}
+			catch (...) {
+				_push_chain(_free.value, n, n, false);
+				throw;
+			}
+			_push_chain(_top.value, n, n, true);
+		}
+
+		// False when the stack was empty
+		bool			try_pop(value_type & value)
+		{
+			node *	n = _pop(_top.value, true);
+
+			if (!n) {
+				return false;
+			}
+			try {
+				value = *n->storage.ptr();
+			}
+			catch (...) {
+				_push_chain(_top.value, n, n, false);
+				throw;
+			}
+			_release(n, n);
+			return true;
+		}
+
+		// Pushes [first, last) with a single exchange, as if one by one:
+		// the last value ends on top
+		template < class InputIterator >
+		void			push_batch(InputIterator first, InputIterator last)
+		{
+			node *	top = NULL;
+			node *	bottom = NULL;
+
+			try {
+				for (; first != last; ++first) {
+					node *	n = _acquire();
+
+					try {
+						_alloc.construct(n->storage.ptr(), *first);
+					}
+					catch (...) {
+						_push_chain(_free.value, n, n, false);
+						throw;
+					}
+					atomic_store(&n->next, top, memory_order_relaxed);
+					top = n;
+					if (!bottom) {
+						bottom = n;
+					}
+				}
+			}
+			catch (...) {
+				if (top) {
+					_release(top, bottom);
+				}
+				throw;
+			}
+			if (top) {
+				_push_chain(_top.value, top, bottom, false);
+			}
+		}
+
+		// Pops up to count values with a single exchange, top first, into
+		// out; returns how many. If copying one out throws, it and the
+		// values under it are left on the stack
+		template < class OutputIterator >
+		size_type		pop_batch(OutputIterator out, size_type count)
+		{
+			unsigned	backoff = 1;
+			node *		first;
+			node *		last;
+			size_type	n;
+
+			if (count == 0) {
+				return 0;
+			}
+			for (;;) {
+				word	top = atomic_load(&_top.value, memory_order_acquire);
+
+				first = _ptr(top);
+				if (!first) {
+					return 0;
+				}
+				last = first;
+				for (n = 1; n < count; n++) {
+					node *	next = atomic_load(&last->next, memory_order_relaxed);
+
+					if (!next) {
+						break ;
+					}
+					last = next;
+				}
+
+				node *	rest = atomic_load(&last->next, memory_order_relaxed);
+
+				if (atomic_compare_exchange(&_top.value, top, _make(rest, top),
+											memory_order_acquire)) {
+					break ;
+				}
+				_backoff(backoff);
+			}
+
+			node *	copied = NULL;
+			node *	cur = first;
+
+			try {
+				for (;;) {
+					*out = *cur->storage.ptr();
+					++out;
+					if (cur == last) {
+						break ;
+					}
+					copied = cur;
+					cur = cur->next;
+				}
+			}
+			catch (...) {
+				if (copied) {
+					_release(first, copied);
+				}
+				_push_chain(_top.value, cur, last, false);
+				throw;
+			}
+			_release(first, last);
+			return n;
+		}
+
+		allocator_type	get_allocator() const	{ return _alloc; }
+
+	// Private member functions
+	private:
+		concurrent_stack (concurrent_stack const &);
+		concurrent_stack &	operator = (concurrent_stack const &);
+
+		static node *	_ptr(word w)
+		{
+			return reinterpret_cast<node *>(static_cast<size_t>(w & _pointer_mask));
+		}
+
+		// p with the tag after prev's
+		static word		_make(node * p, word prev)
+		{
+			return (((prev >> _pointer_bits) + 1) << _pointer_bits)
+				| static_cast<word>(reinterpret_cast<size_t>(p));
+		}
+
+		static void		_backoff(unsigned & spins)
+		{
+			for (unsigned i = 0; i < spins; i++) {
+				cpu_relax();
+			}
+			if (spins < _max_backoff) {
+				spins <<= 1;
+			}
+		}
+
+		// Per-thread xorshift, to spread elimination attempts
+		static size_type	_random()
+		{
+			static __thread size_t	state = 0;
+
+			if (state == 0) {
+				state = hash_mix(this_thread_index() + 1) | 1;
+			}
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return state;
+		}
+
+		// Links first..last, already chained, on top of head
+		void			_push_chain(word & head, node * first, node * last, bool eliminate)
+		{
+			unsigned	backoff = 1;
+			word		top = atomic_load(&head, memory_order_relaxed);
+
+			for (;;) {
+				atomic_store(&last->next, _ptr(top), memory_order_relaxed);
+				if (atomic_compare_exchange(&head, top, _make(first, top),
+											memory_order_release)) {
+					return ;
+				}
+				if (eliminate && _offer(first)) {
+					return ;
+				}
+				_backoff(backoff);
+				top = atomic_load(&head, memory_order_relaxed);
+			}
+		}
+
+		node *			_pop(word & head, bool eliminate)
+		{
+			unsigned	backoff = 1;
+
+			for (;;) {
+				word	top = atomic_load(&head, memory_order_acquire);
+				node *	n = _ptr(top);
+
+				if (!n) {
+					return NULL;
+				}
+				if (atomic_compare_exchange(&head, top,
+						_make(atomic_load(&n->next, memory_order_relaxed), top),
+						memory_order_acquire)) {
+					return n;
+				}
+				if (eliminate && (n = _take()) != NULL) {
+					return n;
+				}
+				_backoff(backoff);
+			}
+		}
+
+		// Leaves n in a free elimination slot for a while; true when a pop
+		// took it. Offers are tagged like the top, so a withdrawal can not
+		// mistake a later offer of the same node for its own
+		bool			_offer(node * n)
+		{
+			word &	slot = _slots[_random() % _elimination_slots].value;
+			word	w = atomic_load(&slot, memory_order_relaxed);
+			word	offer;
+
+			if (_ptr(w)) {
+				return false;
+			}
+			offer = _make(n, w);
+			if (!atomic_compare_exchange(&slot, w, offer, memory_order_release)) {
+				return false;
+			}
+			for (unsigned i = 0; i < _elimination_spins; i++) {
+				if (atomic_load(&slot, memory_order_acquire) != offer) {
+					return true;
+				}
+				cpu_relax();
+			}
+			w = offer;
+			return !atomic_compare_exchange(&slot, w, _make(NULL, offer), memory_order_acquire);
+		}
+
+		node *			_take()
+		{
+			word &	slot = _slots[_random() % _elimination_slots].value;
+			word	w = atomic_load(&slot, memory_order_acquire);
+			node *	n = _ptr(w);
+
+			if (n && atomic_compare_exchange(&slot, w, _make(NULL, w), memory_order_acquire)) {
+				return n;
+			}
+			return NULL;
+		}
+
+		node *			_acquire()
+		{
+			node *	n = _pop(_free.value, false);
+
+			return n ? n : _node_alloc.allocate(1);
+		}
+
+		// Destroys the values of first..last and recycles the nodes
+		void			_release(node * first, node * last)
+		{
+			for (node * n = first; ; n = n->next) {
+				_alloc.destroy(n->storage.ptr());
+				if (n == last) {
+					break ;
+				}
+			}
+			_push_chain(_free.value, first, last, false);
+		}
+
+};
+
+}
+
+#endif
@@ -0,0 +1,583 @@
+#ifndef FT_DEQUE_HPP
+# define FT_DEQUE_HPP
+
+# include <memory>
+# include <algorithm>
+# include <stdexcept>
+
+# include "iterator.hpp"
+# include "utils.hpp"
+# include "vector.hpp"
+
+namespace	ft
+
+{
+
+// Iterators
+// cur walks inside the block [first, last), node is the block's slot in the map
+template < class T, class Ref, class Ptr >
+struct	deque_iterator
+{
+	typedef random_access_iterator_tag			iterator_category;
+	typedef T									value_type;
+	typedef Ptr									pointer;
+	typedef Ref									reference;
+	typedef ptrdiff_t							difference_type;
+
+	typedef deque_iterator<T, T &, T *>			iterator;
+	typedef deque_iterator						iter;
+	typedef T **								map_pointer;
+
+	T *				cur;
+	T *				first;
+	T *				last;
+	map_pointer		node;
+
+	static difference_type	buffer_size()	{ return block_size<T>::value; }
+
+	deque_iterator() : cur(NULL), first(NULL), last(NULL), node(NULL)			{ }
+	deque_iterator(T * c, map_pointer n) : cur(c), first(*n), last(*n + buffer_size()), node(n)	{ }
+	deque_iterator(deque_iterator const & other)
+		: cur(other.cur), first(other.first), last(other.last), node(other.node)	{ }
+	// iterator to const_iterator; a template, so never the copy constructor
+	template < class U >
+	deque_iterator(deque_iterator<U, U &, U *> const & it)
+		: cur(it.cur), first(it.first), last(it.last), node(it.node)			{ }
+
+	iter &			operator = (deque_iterator const & other)
+	{
+		cur = other.cur;
+		first = other.first;
+		last = other.last;
+		node = other.node;
+		return *this;
+	}
+
+	void			set_node(map_pointer new_node)
+	{
+		node = new_node;
+		first = *new_node;
+		last = first + buffer_size();
+	}
+
+	reference		operator * () const						{ return *cur; }
+	pointer			operator -> () const					{ return cur; }
+	reference		operator [] (difference_type n) const	{ return *(*this + n); }
+
+	iter &			operator ++ ()
+	{
+		if (++cur == last) {
+			set_node(node + 1);
+			cur = first;
+		}
+		return *this;
+	}
+
+	iter			operator ++ (int)						{ iter tmp(*this); ++*this; return tmp; }
+
+	iter &			operator -- ()
+	{
+		if (cur == first) {
+			set_node(node - 1);
+			cur = last;
+		}
+		--cur;
+		return *this;
+	}
+
+	iter			operator -- (int)						{ iter tmp(*this); --*this; return tmp; }
+
+	iter &			operator += (difference_type n)
+	{
+		difference_type const	offset = n + (cur - first);
+
+		if (offset >= 0 && offset < buffer_size()) {
+			cur += n;
+		}
+		else {
+			difference_type const	node_offset = offset > 0
+				? offset / buffer_size()
+				: -((-offset - 1) / buffer_size()) - 1;
+			set_node(node + node_offset);
+			cur = first + (offset - node_offset * buffer_size());
+		}
+		return *this;
+	}
+
+	iter			operator + (difference_type n) const	{ iter tmp(*this); return tmp += n; }
+	iter &			operator -= (difference_type n)			{ return *this += -n; }
+	iter			operator - (difference_type n) const	{ iter tmp(*this); return tmp += -n; }
+
+	friend iter		operator + (difference_type n, iter const & it)		{ return it + n; }
+
+	template < class R, class P >
+	difference_type	operator - (deque_iterator<T, R, P> const & rhs) const
+	{
+		return buffer_size() * (node - rhs.node - 1) + (cur - first) + (rhs.last - rhs.cur);
+	}
+
+	template < class R, class P >
+	bool			operator == (deque_iterator<T, R, P> const & rhs) const	{ return cur == rhs.cur; }
+	template < class R, class P >
+	bool			operator != (deque_iterator<T, R, P> const & rhs) const	{ return cur != rhs.cur; }
+	template < class R, class P >
+	bool			operator < (deque_iterator<T, R, P> const & rhs) const
+	{
+		return node == rhs.node ? cur < rhs.cur : node < rhs.node;
+	}
+	template < class R, class P >
+	bool			operator > (deque_iterator<T, R, P> const & rhs) const	{ return rhs < *this; }
+	template < class R, class P >
+	bool			operator <= (deque_iterator<T, R, P> const & rhs) const	{ return !(rhs < *this); }
+	template < class R, class P >
+	bool			operator >= (deque_iterator<T, R, P> const & rhs) const	{ return !(*this < rhs); }
+};
+
+// Double-ended queue: a map of pointers to fixed-size blocks sized by
+// ft::block_size, growing at both ends without moving elements
+template < class T, class Allocator = std::allocator<T> >
+class	deque
+{
+	typedef typename Allocator::template rebind<T *>::other		map_allocator;
+	typedef T **												map_pointer;
+
+	// Type definitions
+	public:
+		typedef T											value_type;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::size_type			size_type;
+		typedef typename allocator_type::difference_type	difference_type;
+		typedef typename allocator_type::reference			reference;
+		typedef typename allocator_type::const_reference	const_reference;
+		typedef typename allocator_type::pointer			pointer;
+		typedef typename allocator_type::const_pointer		const_pointer;
+		typedef deque_iterator<T, T &, T *>					iterator;
+		typedef deque_iterator<T, T const &, T const *>		const_iterator;
+		typedef ft::reverse_iterator<iterator>				reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+	// Private members
+	private:
+		map_pointer		_map;
+		size_type		_map_size;
+		iterator		_start;
+		iterator		_finish;
+		allocator_type	_alloc;
+
+	// Constructors
+	public:
+		explicit deque	(allocator_type const & alloc = allocator_type())
+			: _map(NULL), _map_size(0), _alloc(alloc)
+		{
+			_initialize_map(0);
+		}
+
+		explicit deque	(size_type count, value_type const & value = value_type(),
+						 allocator_type const & alloc = allocator_type())
+			: _map(NULL), _map_size(0), _alloc(alloc)
+		{
+			_initialize_map(0);
+			assign(count, value);
+		}
+
+		template < class InputIterator >
+		deque	(InputIterator first, InputIterator last,
+				 allocator_type const & alloc = allocator_type(),
+				 typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+			: _map(NULL), _map_size(0), _alloc(alloc)
+		{
+			_initialize_map(0);
+			assign(first, last);
+		}
+
+		deque	(deque const & other)
+			: _map(NULL), _map_size(0), _alloc(other._alloc)
+		{
+			_initialize_map(0);
+			assign(other.begin(), other.end());
+		}
+
+		deque &			operator = (deque const & other)
+		{
+			if (this != &other) {
+				assign(other.begin(), other.end());
+			}
+			return *this;
+		}
+
+		~deque()
+		{
+			clear();
+			_deallocate_block(*_start.node);
+			map_allocator(_alloc).deallocate(_map, _map_size);
+		}
+
+	// Member functions
+
+	// Capacity
+		size_type		size() const		{ return static_cast<size_type>(_finish - _start); }
+		size_type		max_size() const	{ return _alloc.max_size(); }
+		bool			empty() const		{ return _finish == _start; }
+
+		void			resize(size_type n, value_type value = value_type())
+		{
+			while (size() > n) {
+				pop_back();
+			}
+			while (size() < n) {
+				push_back(value);
+			}
+		}
+
+	// Modifiers
+		template < class InputIterator >
+		void			assign(InputIterator first, InputIterator last,
+						typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			clear();
+			while (first != last) {
+				push_back(*first++);
+			}
+		}
+
+		void			assign(size_type n, value_type const & value)
+		{
+			value_type	tmp(value);
+
+			clear();
+			while (n) {
+				push_back(tmp);
+				n--;
+			}
+		}
+
+		void			push_back(value_type const & value)
+		{
+			if (_finish.cur != _finish.last - 1) {
+				_alloc.construct(_finish.cur, value);
+				++_finish.cur;
+			}
+			else {
+				value_type	tmp(value);
+
+				_reserve_map_at_back();
+				*(_finish.node + 1) = _allocate_block();
+				try {
+					_alloc.construct(_finish.cur, tmp);
+				}
+				catch (...) {
+					_deallocate_block(*(_finish.node + 1));
+					throw;
+				}
+				_finish.set_node(_finish.node + 1);
+				_finish.cur = _finish.first;
+			}
+		}
+
+		void			push_front(value_type const & value)
+		{
+			if (_start.cur != _start.first) {
+				_alloc.construct(_start.cur - 1, value);
+				--_start.cur;
+			}
+			else {
+				value_type	tmp(value);
+
+				_reserve_map_at_front();
+				*(_start.node - 1) = _allocate_block();
+				try {
+					_alloc.construct(*(_start.node - 1) + iterator::buffer_size() - 1, tmp);
+				}
+				catch (...) {
+					_deallocate_block(*(_start.node - 1));
+					throw;
+				}
+				_start.set_node(_start.node - 1);
+				_start.cur = _start.last - 1;
+			}
+		}
+
+		void			pop_back()
+		{
+			if (_finish.cur == _finish.first) {
+				_deallocate_block(_finish.first);
+				_finish.set_node(_finish.node - 1);
+				_finish.cur = _finish.last;
+			}
+			--_finish.cur;
+			_alloc.destroy(_finish.cur);
+		}
+
+		void			pop_front()
+		{
+			_alloc.destroy(_start.cur);
+			if (_start.cur != _start.last - 1) {
+				++_start.cur;
+			}
+			else {
+				_deallocate_block(_start.first);
+				_start.set_node(_start.node + 1);
+				_start.cur = _start.first;
+			}
+		}
+
+		iterator		insert(iterator pos, value_type const & value)
+		{
+			size_type	index = static_cast<size_type>(pos - _start);
+
+			insert(pos, 1, value);
+			return _start + index;
+		}
+
+		void			insert(iterator pos, size_type count, value_type const & value)
+		{
+			value_type	tmp(value);
+			iterator	gap = _open_gap(static_cast<size_type>(pos - _start), count, tmp);
+
+			for (; count; count--) {
+				*gap++ = tmp;
+			}
+		}
+
+		template < class InputIterator >
+		void			insert(iterator pos, InputIterator first, InputIterator last,
+						typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			ft::vector<value_type>	tmp(first, last);
+
+			if (tmp.empty())
+				return ;
+
+			iterator	gap = _open_gap(static_cast<size_type>(pos - _start), tmp.size(), tmp.front());
+
+			for (size_type i = 0; i < tmp.size(); i++) {
+				*gap++ = tmp[i];
+			}
+		}
+
+		iterator		erase(iterator pos)
+		{
+			return erase(pos, pos + 1);
+		}
+
+		// Shifts whichever side of the range is shorter, then pops from that end
+		iterator		erase(iterator first, iterator last)
+		{
+			size_type const	count = static_cast<size_type>(last - first);
+			size_type const	index = static_cast<size_type>(first - _start);
+
+			if (index < (size() - count) / 2) {
+				_copy_backward(_start, first, last);
+				for (size_type i = 0; i < count; i++) {
+					pop_front();
+				}
+			}
+			else {
+				_copy(last, _finish, first);
+				for (size_type i = 0; i < count; i++) {
+					pop_back();
+				}
+			}
+			return _start + index;
+		}
+
+		void			swap(deque & other)
+		{
+			std::swap(_map, other._map);
+			std::swap(_map_size, other._map_size);
+			std::swap(_start, other._start);
+			std::swap(_finish, other._finish);
+			std::swap(_alloc, other._alloc);
+		}
+
+		// Keeps the block under _start, frees every other one
+		void			clear()
+		{
+			while (!empty()) {
+				pop_back();
+			}
+		}
+
+		allocator_type	get_allocator() const			{ return _alloc; }
+
+	// Element access
+		reference		front()							{ return *_start; }
+		const_reference	front() const					{ return *_start; }
+		reference		back()							{ return *(_finish - 1); }
+		const_reference	back() const					{ return *(_finish - 1); }
+		reference		operator [] (size_type n)		{ return _start[n]; }
+		const_reference	operator [] (size_type n) const	{ return const_iterator(_start)[n]; }
+
+		reference		at (size_type n)
+		{
+			if (n >= size())
+				throw std::out_of_range("deque::at()::out_of_range");
+			return	_start[n];
+		}
+
+		const_reference	at (size_type n) const
+		{
+			if (n >= size())
+				throw std::out_of_range("deque::at()::out_of_range");
+			return	const_iterator(_start)[n];
+		}
+
+	// Iterators
+		iterator				begin()			{ return _start; }
+		const_iterator			begin() const	{ return _start; }
+		iterator				end()			{ return _finish; }
+		const_iterator			end() const		{ return _finish; }
+		reverse_iterator		rbegin()		{ return reverse_iterator(end()); }
+		const_reverse_iterator	rbegin() const	{ return const_reverse_iterator(end()); }
+		reverse_iterator		rend()			{ return reverse_iterator(begin()); }
+		const_reverse_iterator	rend() const	{ return const_reverse_iterator(begin()); }
+
+	// Private member functions
+	private:
+		pointer			_allocate_block()				{ return _alloc.allocate(iterator::buffer_size()); }
+		void			_deallocate_block(pointer p)	{ _alloc.deallocate(p, iterator::buffer_size()); }
+
+		void			_initialize_map(size_type num_elements)
+		{
+			size_type const	num_nodes = num_elements / iterator::buffer_size() + 1;
+
+			_map_size = std::max<size_type>(8, num_nodes + 2);
+			_map = map_allocator(_alloc).allocate(_map_size);
+
+			map_pointer		nstart = _map + (_map_size - num_nodes) / 2;
+			map_pointer		nfinish = nstart + num_nodes;
+			map_pointer		cur = nstart;
+
+			try {
+				for (; cur < nfinish; cur++) {
+					*cur = _allocate_block();
+				}
+			}
+			catch (...) {
+				while (cur != nstart) {
+					_deallocate_block(*--cur);
+				}
+				map_allocator(_alloc).deallocate(_map, _map_size);
+				throw;
+			}
+			_start = iterator(*nstart, nstart);
+			_finish = iterator(*(nfinish - 1) + num_elements % iterator::buffer_size(), nfinish - 1);
+		}
+
+		void			_reserve_map_at_back(size_type nodes_to_add = 1)
+		{
+			if (nodes_to_add + 1 > _map_size - static_cast<size_type>(_finish.node - _map)) {
+				_reallocate_map(nodes_to_add, false);
+			}
+		}
+
+		void			_reserve_map_at_front(size_type nodes_to_add = 1)
+		{
+			if (nodes_to_add > static_cast<size_type>(_start.node - _map)) {
+				_reallocate_map(nodes_to_add, true);
+			}
+		}
+
+		// Recenters the used block pointers in the map, growing it if it is
+		// more than half full; the blocks themselves never move
+		void			_reallocate_map(size_type nodes_to_add, bool add_at_front)
+		{
+			size_type const	old_num_nodes = static_cast<size_type>(_finish.node - _start.node) + 1;
+			size_type const	new_num_nodes = old_num_nodes + nodes_to_add;
+			map_pointer		new_nstart;
+
+			if (_map_size > 2 * new_num_nodes) {
+				new_nstart = _map + (_map_size - new_num_nodes) / 2
+							 + (add_at_front ? nodes_to_add : 0);
+				if (new_nstart < _start.node) {
+					std::copy(_start.node, _finish.node + 1, new_nstart);
+				}
+				else {
+					std::copy_backward(_start.node, _finish.node + 1, new_nstart + old_num_nodes);
+				}
+			}
+			else {
+				size_type const	new_map_size = _map_size + std::max(_map_size, nodes_to_add) + 2;
+				map_pointer		new_map = map_allocator(_alloc).allocate(new_map_size);
+
+				new_nstart = new_map + (new_map_size - new_num_nodes) / 2
+							 + (add_at_front ? nodes_to_add : 0);
+				std::copy(_start.node, _finish.node + 1, new_nstart);
+				map_allocator(_alloc).deallocate(_map, _map_size);
+				_map = new_map;
+				_map_size = new_map_size;
+			}
+			_start.set_node(new_nstart);
+			_finish.set_node(new_nstart + old_num_nodes - 1);
+		}
+
+		// Makes room for count elements before index by growing the shorter
+		// side with filler copies; returns where the caller should assign
+		iterator		_open_gap(size_type index, size_type count, const_reference filler)
+		{
+			if (index < size() / 2) {
+				for (size_type i = 0; i < count; i++) {
+					push_front(filler);
+				}
+				_copy(_start + count, _start + count + index, _start);
+			}
+			else {
+				size_type const	old_size = size();
+
+				for (size_type i = 0; i < count; i++) {
+					push_back(filler);
+				}
+				_copy_backward(_start + index, _start + old_size, _finish);
+			}
+			return _start + index;
+		}
+
+		static iterator	_copy(iterator first, iterator last, iterator dest)
+		{
+			for (; first != last; ++first, ++dest) {
+				*dest = *first;
+			}
+			return dest;
+		}
+
+		static iterator	_copy_backward(iterator first, iterator last, iterator dest)
+		{
+			while (first != last) {
+				*--dest = *--last;
+			}
+			return dest;
+		}
+
+	// Non-member overloads
+	public:
+		friend	bool	operator == (deque const & lhs, deque const & rhs) {
+			return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+		}
+		friend	bool	operator != (deque const & lhs, deque const & rhs) {
+			return !(lhs == rhs);
+		}
+		friend	bool	operator < (deque const & lhs, deque const & rhs) {
+			return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+		friend	bool	operator <= (deque const & lhs, deque const & rhs) {
+			return	!(rhs < lhs);
+		}
+		friend	bool	operator > (deque const & lhs, deque const & rhs) {
+			return rhs < lhs;
+		}
+		friend	bool	operator >= (deque const & lhs, deque const & rhs) {
+			return !(lhs < rhs);
+		}
+
+};
+
+	template < class T, class Alloc >
+	void	swap(deque<T, Alloc> & lhs, deque<T, Alloc> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
+
+
+#endif
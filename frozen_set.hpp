@@ -0,0 +1,104 @@
+#ifndef FT_FROZEN_SET_HPP
+# define FT_FROZEN_SET_HPP
+
+# include <memory>
+
+# include "frozen_tree.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+// Immutable ft::set returned by set::freeze()
+template	<	class Key,
+				class Compare = less<Key>,
+				class Allocator = std::allocator<Key>
+			>
+class	frozen_set
+{
+	// Type definitions
+	public:
+		typedef Key											key_type;
+		typedef Key											value_type;
+		typedef Compare										key_compare;
+		typedef Compare										value_compare;
+		typedef Allocator									allocator_type;
+
+	private:
+		typedef frozen::tree <	key_type,
+								value_type,
+								identity<value_type>,
+								key_compare,
+								Allocator	>				tree_type;
+
+	public:
+		typedef typename tree_type::size_type				size_type;
+		typedef typename tree_type::difference_type			difference_type;
+		typedef typename tree_type::reference				reference;
+		typedef typename tree_type::const_reference			const_reference;
+		typedef typename tree_type::pointer					pointer;
+		typedef typename tree_type::const_pointer			const_pointer;
+		typedef typename tree_type::iterator				iterator;
+		typedef typename tree_type::const_iterator			const_iterator;
+		typedef typename tree_type::reverse_iterator		reverse_iterator;
+		typedef typename tree_type::const_reverse_iterator	const_reverse_iterator;
+
+	// Tree
+	private:
+		tree_type		_tree;
+
+	// Constructors
+	public:
+		explicit frozen_set (key_compare const & comp = key_compare(),
+							 allocator_type const & alloc = allocator_type())
+			: _tree(comp, alloc)							{ }
+
+		// [first, last) holds count values, sorted and unique
+		template < class InputIterator >
+		frozen_set (InputIterator first, InputIterator last, size_type count,
+					key_compare const & comp = key_compare(),
+					allocator_type const & alloc = allocator_type())
+			: _tree(first, last, count, comp, alloc)		{ }
+
+		~frozen_set ()										{ }
+
+	// Iterators
+		const_iterator			begin() const		{ return _tree.begin(); }
+		const_iterator			end() const			{ return _tree.end(); }
+		const_reverse_iterator	rbegin() const		{ return _tree.rbegin(); }
+		const_reverse_iterator	rend() const		{ return _tree.rend(); }
+
+	// Capacity
+		bool				empty() const			{ return _tree.empty(); }
+		size_type			size() const			{ return _tree.size(); }
+		size_type			max_size() const		{ return _tree.max_size(); }
+
+		void			swap(frozen_set & s)					{ _tree.swap(s._tree); }
+
+	// Observers
+		allocator_type	get_allocator() const					{ return _tree.get_allocator(); }
+		key_compare		key_comp() const						{ return _tree.key_comp(); }
+		value_compare	value_comp() const						{ return _tree.key_comp(); }
+
+	// Operations
+		const_iterator	find(key_type const & key) const		{ return _tree.find(key); }
+		size_type		count(key_type const & key) const		{ return _tree.count(key); }
+		const_iterator	lower_bound(key_type const & key) const	{ return _tree.lower_bound(key); }
+		const_iterator	upper_bound(key_type const & key) const	{ return _tree.upper_bound(key); }
+
+		pair<const_iterator,const_iterator>		equal_range(key_type const & key) const {
+			return _tree.equal_range(key);
+		}
+};
+
+	template < class Key, class Comp, class Alloc >
+	void		swap(frozen_set<Key, Comp, Alloc> & lhs, frozen_set<Key, Comp, Alloc> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
+
+
+#endif
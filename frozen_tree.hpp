@@ -0,0 +1,200 @@
+#ifndef FT_FROZEN_TREE_HPP
+# define FT_FROZEN_TREE_HPP
+
+# include <memory>
+
+# include "iterator.hpp"
+# include "vector.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+namespace	frozen
+
+{
+
+// Immutable search structure shared by ft::frozen_map and ft::frozen_set
+//
+// Values are kept in one sorted array for iteration, their keys are copied
+// into a second array in Eytzinger (breadth-first) order: the children of
+// slot k are 2k and 2k + 1, so the top levels of every search share a few
+// cache lines and the next levels can be prefetched before they are needed.
+// The descent has no data dependent branch, only the select of the child;
+// _rank maps the slot a search ends on back to the sorted array.
+template <	typename Key, typename Value, typename KeyOfValue, typename Compare,
+			typename Alloc = std::allocator<Value> >
+class	tree
+{
+	// Type definitions
+	public:
+		typedef Key												key_type;
+		typedef Value											value_type;
+		typedef Compare											key_compare;
+		typedef Alloc											allocator_type;
+		typedef size_t											size_type;
+		typedef ptrdiff_t										difference_type;
+		typedef value_type const &								reference;
+		typedef value_type const &								const_reference;
+		typedef value_type const *								pointer;
+		typedef value_type const *								const_pointer;
+		typedef ft::iterator<const_pointer>						iterator;
+		typedef ft::iterator<const_pointer>						const_iterator;
+		typedef ft::reverse_iterator<const_iterator>			reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>			const_reverse_iterator;
+
+	// Private members
+	private:
+		typedef typename Alloc::template rebind<Key>::other			key_allocator;
+		typedef typename Alloc::template rebind<size_type>::other	rank_allocator;
+
+		// The descendants of slot k a few levels down start at k * stride
+		// and fill one cache line, so a single prefetch covers that level
+		static const size_type	_prefetch_stride = sizeof(Key) < 64 ? 64 / sizeof(Key) : 1;
+
+		ft::vector<value_type, Alloc>				_values;
+		ft::vector<key_type, key_allocator>			_keys;		// slot 0 is unused
+		ft::vector<size_type, rank_allocator>		_rank;
+		key_compare									_comp;
+		KeyOfValue									_key_of;
+
+	// Constructors
+	public:
+		explicit tree(key_compare const & comp = key_compare(),
+					  allocator_type const & alloc = allocator_type())
+			: _values(alloc), _comp(comp)
+		{
+		}
+
+		// [first, last) must be sorted and unique, as a map or set iterates
+		template < class InputIterator >
+		tree(InputIterator first, InputIterator last, size_type count,
+			 key_compare const & comp, allocator_type const & alloc)
+			: _values(alloc), _comp(comp)
+		{
+			_values.reserve(count);
+			while (first != last) {
+				_values.push_back(*first++);
+			}
+			_keys.resize_default_init(_values.size() + 1);
+			_rank.resize_default_init(_values.size() + 1);
+			_build(0, 1);
+		}
+
+	// Iterators
+		const_iterator			begin() const		{ return const_iterator(_values.data()); }
+		const_iterator			end() const			{ return const_iterator(_values.data() + _values.size()); }
+		const_reverse_iterator	rbegin() const		{ return const_reverse_iterator(end()); }
+		const_reverse_iterator	rend() const		{ return const_reverse_iterator(begin()); }
+
+	// Capacity
+		bool			empty() const		{ return _values.empty(); }
+		size_type		size() const		{ return _values.size(); }
+		size_type		max_size() const	{ return _values.max_size(); }
+
+	// Observers
+		key_compare		key_comp() const		{ return _comp; }
+		allocator_type	get_allocator() const	{ return _values.get_allocator(); }
+
+	// Operations
+		const_iterator	find(key_type const & key) const
+		{
+			const_iterator	it = lower_bound(key);
+
+			if (it == end() || _comp(key, _key_of(*it))) {
+				return end();
+			}
+			return it;
+		}
+
+		size_type		count(key_type const & key) const
+		{
+			return find(key) == end() ? 0 : 1;
+		}
+
+		const_iterator	lower_bound(key_type const & key) const
+		{
+			key_type const *	keys = _keys.data();
+			size_type const		n = _values.size();
+			size_type			k = 1;
+
+			while (k <= n) {
+				_prefetch(keys, k);
+				k = 2 * k + static_cast<size_type>(_comp(keys[k], key));
+			}
+			return begin() + _slot_to_index(k);
+		}
+
+		const_iterator	upper_bound(key_type const & key) const
+		{
+			key_type const *	keys = _keys.data();
+			size_type const		n = _values.size();
+			size_type			k = 1;
+
+			while (k <= n) {
+				_prefetch(keys, k);
+				k = 2 * k + static_cast<size_type>(!_comp(key, keys[k]));
+			}
+			return begin() + _slot_to_index(k);
+		}
+
+		pair<const_iterator, const_iterator>	equal_range(key_type const & key) const
+		{
+			return pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+		}
+
+		void			swap(tree & other)
+		{
+			_values.swap(other._values);
+			_keys.swap(other._keys);
+			_rank.swap(other._rank);
+			std::swap(_comp, other._comp);
+		}
+
+	// Private member functions
+	private:
+		// In-order walk of the implicit tree, handing out sorted indexes
+		size_type		_build(size_type index, size_type k)
+		{
+			if (k <= _values.size()) {
+				index = _build(index, 2 * k);
+				_keys[k] = _key_of(_values[index]);
+				_rank[k] = index;
+				index = _build(index + 1, 2 * k + 1);
+			}
+			return index;
+		}
+
+		// The search went right (bit 1) until the answer, then left once:
+		// dropping those trailing ones and the left turn gives its slot,
+		// 0 when the search never went left and the answer is end()
+		size_type		_slot_to_index(size_type k) const
+		{
+# if defined(__GNUC__) || defined(__clang__)
+			k >>= __builtin_ffsl(static_cast<long>(~k));
+# else
+			while (k & 1) {
+				k >>= 1;
+			}
+			k >>= 1;
+# endif
+			return k ? _rank[k] : _values.size();
+		}
+
+		static void		_prefetch(key_type const * keys, size_type k)
+		{
+# if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(keys + k * _prefetch_stride);
+# else
+			(void)keys;
+			(void)k;
+# endif
+		}
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef FT_GROWTH_POLICY_HPP
+# define FT_GROWTH_POLICY_HPP
+
+# include <cstddef>
+# include <algorithm>
+
+namespace	ft
+
+{
+
+// Growth policies for ft::vector
+// recommend() returns the new capacity (in elements) when new_size elements
+// no longer fit in cap; the result is >= new_size and <= max_size
+
+struct	growth_double
+{
+	static size_t	recommend(size_t cap, size_t new_size, size_t max_size, size_t)
+	{
+		if (cap >= max_size / 2) {
+			return max_size;
+		}
+		return std::max<size_t>(2 * cap, new_size);
+	}
+};
+
+// Factor 1.5: a freed block can eventually be reused by later growth
+struct	growth_golden
+{
+	static size_t	recommend(size_t cap, size_t new_size, size_t max_size, size_t)
+	{
+		if (cap >= max_size / 3 * 2) {
+			return max_size;
+		}
+		return std::max<size_t>(cap + cap / 2, new_size);
+	}
+};
+
+// Doubles, then rounds the byte size up to whole pages
+template < size_t PageSize = 4096 >
+struct	growth_page_rounded
+{
+	static size_t	recommend(size_t cap, size_t new_size, size_t max_size, size_t value_size)
+	{
+		size_t const	n = growth_double::recommend(cap, new_size, max_size, value_size);
+		size_t const	rounded = (n * value_size + PageSize - 1) / PageSize * PageSize / value_size;
+
+		return (rounded < n || rounded > max_size) ? n : rounded;
+	}
+};
+
+// Grows by ~25% steps and rounds the byte size up to the size classes
+// of jemalloc-like allocators (four classes per power of two), so the
+// capacity matches what the allocator would hand out anyway
+struct	growth_size_class
+{
+	static size_t	recommend(size_t cap, size_t new_size, size_t max_size, size_t value_size)
+	{
+		if (cap >= max_size / 5 * 4) {
+			return max_size;
+		}
+
+		size_t const	n = std::max<size_t>(cap + cap / 4, new_size);
+		size_t const	bytes = size_class(n * value_size);
+
+		// Rounding up can wrap around near the top of size_t; n itself
+		// always fits, so the result never drops below new_size
+		if (bytes < n * value_size) {
+			return n;
+		}
+		if (bytes / value_size > max_size) {
+			return max_size;
+		}
+		return bytes / value_size;
+	}
+
+	static size_t	size_class(size_t bytes)
+	{
+		size_t	pow2 = 16;
+
+		if (bytes <= pow2) {
+			return pow2;
+		}
+		while (pow2 * 2 < bytes && pow2 * 2 > pow2) {
+			pow2 *= 2;
+		}
+
+		size_t const	step = pow2 / 4;
+
+		return (bytes + step - 1) / step * step;
+	}
+};
+
+}
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef FT_HUGE_PAGE_ALLOCATOR_HPP
+# define FT_HUGE_PAGE_ALLOCATOR_HPP
+
+# include <new>
+# include <cstddef>
+# include <sys/mman.h>
+
+namespace	ft
+
+{
+
+// 2 MB aligned anonymous mappings, backed by huge pages when the kernel allows
+struct	huge_pages
+{
+	static const size_t	size = size_t(2) << 20;
+
+	static size_t	round(size_t bytes)
+	{
+		return (bytes + size - 1) / size * size;
+	}
+
+	// Tries a hugetlbfs mapping first, then an over-sized regular mapping
+	// trimmed to alignment and advised for transparent huge pages;
+	// without either the region simply stays on regular pages
+	static void *	map(size_t bytes)
+	{
+		size_t const	len = round(bytes);
+		void *			p;
+
+# ifdef MAP_HUGETLB
+		p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+				 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (p != MAP_FAILED) {
+			return p;
+		}
+# endif
+		p = mmap(NULL, len + size, PROT_READ | PROT_WRITE,
+				 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (p == MAP_FAILED) {
+			throw std::bad_alloc();
+		}
+
+		char *	raw = static_cast<char *>(p);
+		char *	aligned = reinterpret_cast<char *>(round(reinterpret_cast<size_t>(raw)));
+
+		if (aligned != raw) {
+			munmap(raw, aligned - raw);
+		}
+		if (aligned + len != raw + len + size) {
+			munmap(aligned + len, raw + size - aligned);
+		}
+# ifdef MADV_HUGEPAGE
+		madvise(aligned, len, MADV_HUGEPAGE);
+# endif
+		return aligned;
+	}
+
+	static void		unmap(void * p, size_t bytes)
+	{
+		munmap(p, round(bytes));
+	}
+};
+
+// Free list of Size-byte slots carved out of huge-page regions, shared by
+// every allocator with the same slot size; regions are kept for reuse
+// for the lifetime of the process
+template < size_t Size >
+class	huge_page_slab
+{
+	struct	slot	{ slot * next; };
+
+	static slot *		_free;
+	static char *		_cur;
+	static char *		_end;
+	static int			_lock;
+
+	struct	guard
+	{
+		guard()		{ while (__sync_lock_test_and_set(&_lock, 1)) { } }
+		~guard()	{ __sync_lock_release(&_lock); }
+	};
+
+	public:
+		static void *	allocate()
+		{
+			guard	g;
+
+			if (_free) {
+				slot *	s = _free;
+				_free = s->next;
+				return s;
+			}
+			if (_cur == _end) {
+				_cur = static_cast<char *>(huge_pages::map(huge_pages::size));
+				_end = _cur + huge_pages::size / Size * Size;
+			}
+
+			void *	p = _cur;
+			_cur += Size;
+			return p;
+		}
+
+		static void		deallocate(void * p)
+		{
+			guard	g;
+			slot *	s = static_cast<slot *>(p);
+
+			s->next = _free;
+			_free = s;
+		}
+};
+
+template < size_t Size >
+typename huge_page_slab<Size>::slot *	huge_page_slab<Size>::_free = NULL;
+template < size_t Size >
+char *		huge_page_slab<Size>::_cur = NULL;
+template < size_t Size >
+char *		huge_page_slab<Size>::_end = NULL;
+template < size_t Size >
+int			huge_page_slab<Size>::_lock = 0;
+
+// std::allocator compatible allocator for ft::vector, ft::map and ft::set:
+// requests of at least Threshold bytes get their own 2 MB aligned huge-page
+// mapping, single small objects (tree nodes) come from huge-page slabs,
+// everything else goes through operator new
+template < class T, size_t Threshold = huge_pages::size >
+class	huge_page_allocator
+{
+	// Type definitions
+	public:
+		typedef T				value_type;
+		typedef T *				pointer;
+		typedef T const *		const_pointer;
+		typedef T &				reference;
+		typedef T const &		const_reference;
+		typedef size_t			size_type;
+		typedef ptrdiff_t		difference_type;
+
+		template < class U >
+		struct	rebind		{ typedef huge_page_allocator<U, Threshold> other; };
+
+	private:
+		static const size_type	_slot_size = (sizeof(T) + 15) / 16 * 16;
+		static const size_type	_max_slot_size = 256;
+
+	// Constructors
+	public:
+		huge_page_allocator()												{ }
+		huge_page_allocator(huge_page_allocator const &)					{ }
+		template < class U >
+		huge_page_allocator(huge_page_allocator<U, Threshold> const &)		{ }
+		~huge_page_allocator()												{ }
+
+		huge_page_allocator &	operator = (huge_page_allocator const &)	{ return *this; }
+
+	// Member functions
+		pointer			address(reference x) const			{ return &x; }
+		const_pointer	address(const_reference x) const	{ return &x; }
+		size_type		max_size() const					{ return size_type(-1) / sizeof(T); }
+
+		pointer			allocate(size_type n, void const * = 0)
+		{
+			if (n > max_size()) {
+				throw std::bad_alloc();
+			}
+
+			size_type const	bytes = n * sizeof(T);
+
+			if (bytes >= Threshold) {
+				return static_cast<pointer>(huge_pages::map(bytes));
+			}
+			if (n == 1 && _slot_size <= _max_slot_size) {
+				return static_cast<pointer>(huge_page_slab<_slot_size>::allocate());
+			}
+			return static_cast<pointer>(::operator new(bytes));
+		}
+
+		void			deallocate(pointer p, size_type n)
+		{
+			size_type const	bytes = n * sizeof(T);
+
+			if (bytes >= Threshold) {
+				huge_pages::unmap(p, bytes);
+			}
+			else if (n == 1 && _slot_size <= _max_slot_size) {
+				huge_page_slab<_slot_size>::deallocate(p);
+			}
+			else {
+				::operator delete(p);
+			}
+		}
+
+		void			construct(pointer p, const_reference value)	{ new (static_cast<void *>(p)) T(value); }
+		void			destroy(pointer p)							{ p->~T(); }
+
+	// Non-member overloads
+		friend	bool	operator == (huge_page_allocator const &, huge_page_allocator const &) {
+			return true;
+		}
+		friend	bool	operator != (huge_page_allocator const &, huge_page_allocator const &) {
+			return false;
+		}
+};
+
+}
+
+#endif
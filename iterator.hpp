@@ -58,6 +58,7 @@ class	iterator
 
 	public:
 		iterator() : _it(NULL)										{ }
+		iterator(iterator const & other) : _it(other._it)			{ }
 		template <class Iter>
 		iterator(iterator<Iter> const & other) : _it(other.base())	{ }
 		iterator(iterator_type const it) : _it(it)					{ }
@@ -113,6 +114,7 @@ class	reverse_iterator
 
 	public:
 		reverse_iterator() : _it(NULL)												{ }
+		reverse_iterator(reverse_iterator const & other) : _it(other._it)			{ }
 		template <class Iter>
 		reverse_iterator(reverse_iterator<Iter> const & other) : _it(other.base())	{ }
 		explicit reverse_iterator(iterator_type it) : _it(it)						{ }
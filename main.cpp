@@ -1,7 +1,11 @@
 #include <iostream>
 #include <string>
 #include <fstream>
-#include <deque>
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <map>
+#include <set>
 
 #include "colors.h"
 
@@ -14,18 +18,52 @@
 
 #if		STD //CREATE A REAL STL EXAMPLE
 	#include <vector>
+	#include <deque>
 	#include <stack>
+	#include <queue>
 	#include <map>
 	#include <set>
 	namespace ft = std;
+	typedef std::vector<int>				small_vector_int;
+	typedef std::vector<int>				static_vector_int;
+	typedef std::vector<int>				segmented_vector_int;
+	typedef std::multimap<int, int>			grouped_multimap_int;
+	typedef std::multiset<int>				grouped_multiset_int;
+	typedef std::vector<int>				huge_page_vector_int;
+	typedef std::vector<int>				huge_page_small_vector_int;
+	typedef std::map<int, int>				huge_page_map_int;
 #elif	FT
 	#include "vector.hpp"
+	#include "deque.hpp"
 	#include "stack.hpp"
+	#include "queue.hpp"
+	#include "priority_queue.hpp"
 	#include "map.hpp"
 	#include "set.hpp"
+	#include "small_vector.hpp"
+	typedef ft::small_vector<int, 8>		small_vector_int;
+	#include "static_vector.hpp"
+	typedef ft::static_vector<int, 8>		static_vector_int;
+	#include "segmented_vector.hpp"
+	typedef ft::segmented_vector<int, 4>	segmented_vector_int;
+	#include "multimap.hpp"
+	#include "multiset.hpp"
+	typedef ft::grouped_multimap<int, int>	grouped_multimap_int;
+	typedef ft::grouped_multiset<int>		grouped_multiset_int;
+	#include "huge_page_allocator.hpp"
+	#include "memory_resource.hpp"
+	#include "mmap_vector.hpp"
+	#include "mapped_map.hpp"
+	#include "mapped_set.hpp"
+	#include "parallel_map.hpp"
+	typedef ft::vector<int, ft::huge_page_allocator<int> >			huge_page_vector_int;
+	typedef ft::vector<int, ft::huge_page_allocator<int, 4096> >	huge_page_small_vector_int;
+	typedef ft::map<int, int, std::less<int>,
+					ft::huge_page_allocator<ft::pair<int const, int> > >	huge_page_map_int;
 #endif
 
 #include <stdlib.h>
+#include <unistd.h>
 
 #define MAX_RAM 4294967296
 #define BUFFER_SIZE 4096
@@ -62,6 +100,1120 @@ void	print_testing(std::string str)
 	std::cout << CYAN << str << RESET << std::endl;
 }
 
+// small_vector keeps up to 8 elements inline and shrink_to_fit() moves
+// them back there, static_vector holds 8 at most and throws past them; the
+// STL run stands for them with a vector whose capacity is shrunk by a copy
+// and swap and a push_back() that checks the bound itself
+#if		STD
+template < class Vector >
+bool	is_inline(Vector const & v)		{ return v.capacity() <= 8; }
+template < class Vector >
+void	shrink_to_fit(Vector & v)			{ Vector(v).swap(v); }
+template < class Vector >
+void	push_back_bounded(Vector & v, typename Vector::value_type const & value)
+{
+	if (v.size() == 8) {
+		throw std::length_error("static_vector::push_back()::length_error");
+	}
+	v.push_back(value);
+}
+#elif	FT
+template < class Vector >
+bool	is_inline(Vector const & v)		{ return v.is_inline(); }
+template < class Vector >
+void	shrink_to_fit(Vector & v)			{ v.shrink_to_fit(); }
+template < class Vector >
+void	push_back_bounded(Vector & v, typename Vector::value_type const & value)
+{
+	v.push_back(value);
+}
+#endif
+
+template < class Vector >
+void	print_vector(Vector const & v)
+{
+	for (typename Vector::const_iterator it = v.begin(); it != v.end(); it++) {
+		std::cout << *it << ' ';
+	}
+	std::cout << std::endl << "size = " << v.size() << std::endl;
+}
+
+// The default_init constructor and resize_default_init() leave new ints
+// uninitialized: the STL run value-initializes them, and only the elements
+// that were already there are printed
+#if		STD
+template < class Vector >
+Vector	make_default_init(typename Vector::size_type n)			{ return Vector(n); }
+template < class Vector >
+void	resize_default_init(Vector & v, typename Vector::size_type n)	{ v.resize(n); }
+#elif	FT
+template < class Vector >
+Vector	make_default_init(typename Vector::size_type n)			{ return Vector(n, ft::default_init); }
+template < class Vector >
+void	resize_default_init(Vector & v, typename Vector::size_type n)	{ v.resize_default_init(n); }
+#endif
+
+// Growth policies: the STL run prints the capacities each policy is meant
+// to give, from a vector that only models its capacity
+#if		STD
+struct	model_double
+{
+	static size_t	recommend(size_t cap, size_t n)		{ return std::max(2 * cap, n); }
+};
+
+struct	model_golden
+{
+	static size_t	recommend(size_t cap, size_t n)		{ return std::max(cap + cap / 2, n); }
+};
+
+struct	model_page_rounded
+{
+	static size_t	recommend(size_t cap, size_t n)
+	{
+		return (std::max(2 * cap, n) * sizeof(int) + 4095) / 4096 * 4096 / sizeof(int);
+	}
+};
+
+struct	model_size_class
+{
+	static size_t	recommend(size_t cap, size_t n)
+	{
+		size_t const	bytes = std::max(cap + cap / 4, n) * sizeof(int);
+		size_t			pow2 = 16;
+
+		if (bytes <= pow2) {
+			return pow2 / sizeof(int);
+		}
+		while (pow2 * 2 < bytes) {
+			pow2 *= 2;
+		}
+		return (bytes + pow2 / 4 - 1) / (pow2 / 4) * (pow2 / 4) / sizeof(int);
+	}
+};
+
+template < class Model >
+class	modeled_vector
+{
+	std::vector<int>	_v;
+	size_t				_cap;
+
+	public:
+		modeled_vector() : _cap(0)			{ }
+
+		size_t	size() const				{ return _v.size(); }
+		size_t	capacity() const			{ return _cap; }
+		size_t	wasted_bytes() const		{ return (_cap - _v.size()) * sizeof(int); }
+		void	shrink_to_fit()				{ _cap = _v.size(); }
+
+		void	push_back(int value)
+		{
+			if (_v.size() == _cap) {
+				_cap = Model::recommend(_cap, _v.size() + 1);
+			}
+			_v.push_back(value);
+		}
+
+		void	resize(size_t n)
+		{
+			if (n > _cap) {
+				_cap = Model::recommend(_cap, n);
+			}
+			_v.resize(n);
+		}
+};
+
+typedef modeled_vector<model_double>			vector_growth_double;
+typedef modeled_vector<model_golden>			vector_growth_golden;
+typedef modeled_vector<model_page_rounded>		vector_growth_page_rounded;
+typedef modeled_vector<model_size_class>		vector_growth_size_class;
+#elif	FT
+typedef ft::vector<int, std::allocator<int>, ft::growth_double>				vector_growth_double;
+typedef ft::vector<int, std::allocator<int>, ft::growth_golden>				vector_growth_golden;
+typedef ft::vector<int, std::allocator<int>, ft::growth_page_rounded<> >	vector_growth_page_rounded;
+typedef ft::vector<int, std::allocator<int>, ft::growth_size_class>			vector_growth_size_class;
+#endif
+
+template < class Vector >
+void	test_growth(std::string const & name)
+{
+	Vector	v;
+	size_t	last = v.capacity();
+
+	print_testing("Testing " + name + ":");
+	std::cout << "capacities:";
+	for (int i = 0; i < 5000; i++) {
+		v.push_back(i);
+		if (v.capacity() != last) {
+			last = v.capacity();
+			std::cout << ' ' << last;
+		}
+	}
+	std::cout << std::endl;
+	v.resize(12000);
+	std::cout << "resize(12000): capacity = " << v.capacity() << std::endl;
+	v.resize(100);
+	std::cout << "resize(100): capacity = " << v.capacity() << ", wasted_bytes() = " << v.wasted_bytes() << std::endl;
+	v.shrink_to_fit();
+	std::cout << "shrink_to_fit(): capacity = " << v.capacity() << ", wasted_bytes() = " << v.wasted_bytes() << std::endl;
+	v.push_back(100);
+	std::cout << "push_back(): capacity = " << v.capacity() << ", wasted_bytes() = " << v.wasted_bytes() << std::endl;
+}
+
+// erase_below() and erase_above() are extensions: the STL run erases the
+// same ranges through iterators
+#if		STD
+template < class Tree, class Key >
+void	erase_below(Tree & tree, Key const & key)	{ tree.erase(tree.begin(), tree.lower_bound(key)); }
+template < class Tree, class Key >
+void	erase_above(Tree & tree, Key const & key)	{ tree.erase(tree.upper_bound(key), tree.end()); }
+#elif	FT
+template < class Tree, class Key >
+void	erase_below(Tree & tree, Key const & key)	{ tree.erase_below(key); }
+template < class Tree, class Key >
+void	erase_above(Tree & tree, Key const & key)	{ tree.erase_above(key); }
+#endif
+
+template < class Map >
+void	print_map(Map const & m)
+{
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); it++) {
+		std::cout << it->first << ':' << it->second << ' ';
+	}
+	std::cout << std::endl << "size = " << m.size() << std::endl;
+}
+
+template < class Set >
+void	print_set(Set const & s)
+{
+	for (typename Set::const_iterator it = s.begin(); it != s.end(); it++) {
+		std::cout << *it << ' ';
+	}
+	std::cout << std::endl << "size = " << s.size() << std::endl;
+}
+
+// Run on ft::multimap and ft::grouped_multimap, which must print the same;
+// hints are end() or the end of the key's run, where the STL inserts too
+template < class Multimap >
+void	test_multimap(Multimap & mm)
+{
+	typedef typename Multimap::iterator		iterator;
+	typedef typename Multimap::value_type	value_type;
+
+	print_testing("Testing insert(), hinted and ranged:");
+	for (int i = 0; i < 300; i++) {
+		mm.insert(value_type(i % 37, i));
+	}
+	for (int i = 300; i < 400; i++) {
+		mm.insert(mm.end(), value_type(i % 41, i));
+		mm.insert(mm.upper_bound(i % 13), value_type(i % 13, -i));
+		mm.insert(mm.upper_bound(i % 53), value_type(i % 53, i * 2));
+	}
+
+	Multimap	more;
+
+	for (int i = 0; i < 50; i++) {
+		more.insert(value_type(i % 5 * 9, 1000 + i));
+	}
+	mm.insert(more.begin(), more.end());
+	print_map(mm);
+	print_testing("Testing count() and equal_range():");
+	for (int k = -1; k < 42; k += 6) {
+		ft::pair<iterator, iterator>	range = mm.equal_range(k);
+
+		std::cout << "count(" << k << ") = " << mm.count(k) << ":";
+		for (; range.first != range.second; range.first++) {
+			std::cout << ' ' << range.first->second;
+		}
+		std::cout << std::endl;
+	}
+	print_testing("Testing erase(key), erase(pos) and erase(first, last):");
+	std::cout << "erase(9) = " << mm.erase(9) << ", erase(100) = " << mm.erase(100) << std::endl;
+	mm.erase(mm.find(3));
+	mm.erase(mm.begin());
+	mm.erase(--mm.end());
+	mm.erase(mm.lower_bound(12), mm.upper_bound(20));
+	mm.erase(mm.find(5), mm.find(6));
+	print_map(mm);
+	std::cout << "count(15) = " << mm.count(15) << ", count(5) = " << mm.count(5) << std::endl;
+}
+
+template < class Multiset >
+void	test_multiset(Multiset & ms)
+{
+	print_testing("Testing insert(), hinted and ranged:");
+	for (int i = 0; i < 300; i++) {
+		ms.insert(i % 23);
+	}
+	for (int i = 0; i < 100; i++) {
+		ms.insert(ms.end(), i % 31);
+	}
+
+	ft::vector<int>	more;
+
+	for (int i = 0; i < 40; i++) {
+		more.push_back(i % 4 * 10);
+	}
+	ms.insert(more.begin(), more.end());
+	print_set(ms);
+	print_testing("Testing count() and equal_range():");
+	for (int k = -1; k < 32; k += 5) {
+		std::cout << "count(" << k << ") = " << ms.count(k) << ", equal_range length "
+				  << ft::distance(ms.equal_range(k).first, ms.equal_range(k).second) << std::endl;
+	}
+	print_testing("Testing erase(key), erase(pos) and erase(first, last):");
+	std::cout << "erase(10) = " << ms.erase(10) << ", erase(100) = " << ms.erase(100) << std::endl;
+	ms.erase(ms.find(3));
+	ms.erase(ms.begin());
+	ms.erase(ms.lower_bound(12), ms.upper_bound(20));
+	print_set(ms);
+}
+
+// Runs a vector and a map through growth, copies, swaps and erasure; used
+// to check the allocators against the STL run's std::allocator
+template < class Vector, class Map >
+void	test_allocated(Vector & v, Map & m)
+{
+	long	sum = 0;
+
+	print_testing("Testing vector growth past the threshold:");
+	for (int i = 0; i < 300000; i++) {
+		v.push_back(i % 1000);
+	}
+	v.erase(v.begin() + 1000, v.begin() + 2000);
+	v.insert(v.begin() + 10, 5000, -1);
+	for (typename Vector::size_type i = 0; i < v.size(); i++) {
+		sum += v[i];
+	}
+	std::cout << "size " << v.size() << ", sum " << sum << ", v[9..11] " << v[9] << ' ' << v[10] << ' ' << v[5010] << std::endl;
+
+	Vector	small(v.begin(), v.begin() + 37);
+	Vector	copy(v);
+
+	small.swap(copy);
+	std::cout << "after swap: " << small.size() << ' ' << copy.size() << ", equal " << (small == v ? "true" : "false") << std::endl;
+	copy.resize(1);
+	copy.reserve(700000);
+	std::cout << "copy " << copy.size() << ' ' << copy[0] << std::endl;
+
+	print_testing("Testing map nodes:");
+	for (int i = 0; i < 5000; i++) {
+		m[(i * 7919) % 10007] = i;
+	}
+	for (int i = 0; i < 10007; i += 3) {
+		m.erase(i);
+	}
+	for (int i = 0; i < 1000; i++) {
+		m.insert(typename Map::value_type(i * 11, -i));
+	}
+	sum = 0;
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); it++) {
+		sum += it->first * 3 + it->second;
+	}
+	std::cout << "size " << m.size() << ", sum " << sum << ", front " << m.begin()->first
+			  << ", back " << m.rbegin()->first << std::endl;
+
+	Map		m_copy(m);
+	Map		m_other;
+
+	m_other[1] = 1;
+	m_copy.swap(m_other);
+	std::cout << "after swap: " << m_copy.size() << ' ' << m_other.size() << ", equal " << (m_other == m ? "true" : "false") << std::endl;
+	m.clear();
+	m[4] = 2;
+	print_map(m);
+}
+
+// Elements over-aligned to a cache line, to take the alignment path of
+// the memory resources; std::allocator before C++17 ignores extended
+// alignment, so the STL run uses a plain struct
+#if		STD
+struct	aligned_int
+{
+	int		value;
+};
+
+bool	is_aligned(void const *)								{ return true; }
+#elif	FT
+struct	aligned_int
+{
+	int		value;
+} __attribute__((aligned(64)));
+
+bool	is_aligned(void const * p)
+{
+	return reinterpret_cast<size_t>(p) % ft::alignment_of<aligned_int>::value == 0;
+}
+#endif
+
+template < class Vector, class Map >
+void	test_aligned(Vector & v, Map & m)
+{
+	bool	aligned = true;
+	long	sum = 0;
+
+	print_testing("Testing over-aligned elements:");
+	for (int i = 0; i < 200; i++) {
+		aligned_int	a = { i };
+
+		v.push_back(a);
+		m[i * 5] = a;
+		aligned = aligned && is_aligned(&v[0]) && is_aligned(&m[i * 5]);
+	}
+	v.erase(v.begin() + 50, v.end());
+	m.erase(m.find(100), m.end());
+	for (typename Vector::size_type i = 0; i < v.size(); i++) {
+		sum += v[i].value;
+	}
+	for (typename Map::iterator it = m.begin(); it != m.end(); it++) {
+		sum += it->second.value;
+	}
+	std::cout << "aligned " << (aligned ? "yes" : "no") << ", sum " << sum
+			  << ", sizes " << v.size() << ' ' << m.size() << std::endl;
+}
+
+// Memory resources: the STL run uses std::allocator
+#if		STD
+void	test_memory_resource(int)
+{
+	std::vector<int>			v;
+	std::map<int, int>			m;
+	std::vector<aligned_int>	v_aligned;
+	std::map<int, aligned_int>	m_aligned;
+
+	test_allocated(v, m);
+	test_aligned(v_aligned, m_aligned);
+}
+#elif	FT
+typedef ft::vector<int, ft::polymorphic_allocator<int> >				pmr_vector_int;
+typedef ft::map<int, int, std::less<int>,
+				ft::polymorphic_allocator<ft::pair<int const, int> > >	pmr_map_int;
+typedef ft::vector<aligned_int, ft::polymorphic_allocator<aligned_int> >	pmr_vector_aligned;
+typedef ft::map<int, aligned_int, std::less<int>,
+				ft::polymorphic_allocator<ft::pair<int const, aligned_int> > >	pmr_map_aligned;
+
+// The containers copied or swapped inside test_allocated() use the default
+// resource, so swapping them exercises the allocator swap
+void	test_on_resource(ft::memory_resource * r)
+{
+	pmr_vector_int		v(r);
+	pmr_map_int			m(std::less<int>(), r);
+	pmr_vector_aligned	v_aligned(r);
+	pmr_map_aligned		m_aligned(std::less<int>(), r);
+
+	test_allocated(v, m);
+	test_aligned(v_aligned, m_aligned);
+}
+
+void	test_memory_resource(int kind)
+{
+	if (kind == 0) {
+		ft::monotonic_buffer_resource	r;
+		test_on_resource(&r);
+	}
+	else if (kind == 1) {
+		char							buffer[4096];
+		ft::monotonic_buffer_resource	r(buffer, sizeof(buffer));
+		test_on_resource(&r);
+	}
+	else {
+		ft::unsynchronized_pool_resource	r;
+		test_on_resource(&r);
+	}
+}
+#endif
+
+// mmap_vector: the STL run models the file with a vector that keeps its
+// elements across close() and open()
+#if		STD
+class	mmap_vector_int : public std::vector<int>
+{
+	public:
+		explicit mmap_vector_int(char const *)					{ }
+
+		void	open(char const *)								{ }
+		void	close()											{ }
+		void	sync()											{ }
+		void	shrink_to_fit()									{ }
+		bool	is_open() const									{ return true; }
+};
+#elif	FT
+typedef ft::mmap_vector<int>	mmap_vector_int;
+#endif
+
+template < class Vector >
+bool	same_elements(Vector const & v, std::vector<int> const & model)
+{
+	if (v.size() != model.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < model.size(); i++) {
+		if (v[i] != model[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void	test_mmap_vector(char const * path)
+{
+	mmap_vector_int		v(path);
+	std::vector<int>	model;
+
+	print_testing("Testing push_back(), insert() and erase() on a new file:");
+	for (int i = 0; i < 10000; i++) {
+		v.push_back(i * 7 % 1000);
+		model.push_back(i * 7 % 1000);
+	}
+	v.insert(v.begin() + 100, 50, -1);
+	model.insert(model.begin() + 100, 50, -1);
+	v.erase(v.begin() + 5000, v.begin() + 6000);
+	model.erase(model.begin() + 5000, model.begin() + 6000);
+	v.sync();
+	std::cout << "size " << v.size() << ", matches std::vector: " << (same_elements(v, model) ? "yes" : "no") << std::endl;
+	print_testing("Testing close() and open() again:");
+	v.close();
+	v.open(path);
+	std::cout << "open " << (v.is_open() ? "yes" : "no") << ", size " << v.size()
+			  << ", matches std::vector: " << (same_elements(v, model) ? "yes" : "no") << std::endl;
+	print_testing("Testing growth, shrink_to_fit() and reopening:");
+	v.resize(30000, 3);
+	model.resize(30000, 3);
+	v.pop_back();
+	model.pop_back();
+	v.shrink_to_fit();
+	v.close();
+	v.open(path);
+	std::cout << "size " << v.size() << ", back " << v.back() << ", matches std::vector: "
+			  << (same_elements(v, model) ? "yes" : "no") << std::endl;
+	v.clear();
+	v.close();
+	v.open(path);
+	std::cout << "after clear(): empty " << (v.empty() ? "yes" : "no") << std::endl;
+}
+
+// mapped_map and mapped_set: the STL run keeps the "files" in memory,
+// a corrupt file is one that is gone
+#if		STD
+template < class Container >
+std::map<std::string, Container> &	mapped_files()
+{
+	static std::map<std::string, Container>	files;
+
+	return files;
+}
+
+template < class Container >
+class	mapped_model : public Container
+{
+	public:
+		explicit mapped_model(char const * path)				{ open(path); }
+
+		void	open(char const * path)
+		{
+			typename std::map<std::string, Container>::iterator	it = mapped_files<Container>().find(path);
+
+			if (it == mapped_files<Container>().end()) {
+				throw std::runtime_error("mapped::open()::bad_file");
+			}
+			Container::operator=(it->second);
+		}
+
+		template < class InputIterator >
+		static void	write(char const * path, InputIterator first, InputIterator last)
+		{
+			mapped_files<Container>()[path] = Container(first, last);
+		}
+};
+
+typedef mapped_model< std::map<int, int> >	mapped_map_int;
+typedef mapped_model< std::set<int> >		mapped_set_int;
+
+void	corrupt_mapped_file(char const * path, int)
+{
+	mapped_files< std::map<int, int> >().erase(path);
+	mapped_files< std::set<int> >().erase(path);
+}
+#elif	FT
+typedef ft::mapped_map<int, int>	mapped_map_int;
+typedef ft::mapped_set<int>			mapped_set_int;
+
+// 0 cuts the file inside the header, 1 inside the values, 2 breaks the magic
+void	corrupt_mapped_file(char const * path, int how)
+{
+	if (how == 0) {
+		truncate(path, 32);
+	}
+	else if (how == 1) {
+		truncate(path, 64 + 10 * sizeof(ft::mapped_pair<int, int>));
+	}
+	else {
+		std::fstream	f(path, std::ios::in | std::ios::out | std::ios::binary);
+
+		f.seekp(0);
+		f.put('X');
+	}
+}
+#endif
+
+// Every stored key, every gap between keys and both ends
+template < class Mapped, class Model >
+bool	same_lookups(Mapped const & m, Model const & model, int max_key)
+{
+	for (int k = -1; k <= max_key + 1; k++) {
+		typename Mapped::const_iterator	lower = m.lower_bound(k);
+		typename Mapped::const_iterator	upper = m.upper_bound(k);
+		typename Model::const_iterator	model_lower = model.lower_bound(k);
+		typename Model::const_iterator	model_upper = model.upper_bound(k);
+
+		if ((m.find(k) == m.end()) != (model.find(k) == model.end())
+			|| m.count(k) != model.count(k)
+			|| static_cast<long>(ft::distance(m.begin(), lower)) != std::distance(model.begin(), model_lower)
+			|| static_cast<long>(ft::distance(m.begin(), upper)) != std::distance(model.begin(), model_upper)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void	test_mapped(char const * path, int n)
+{
+	std::map<int, int>	model;
+	std::set<int>		set_model;
+
+	for (int i = 0; i < n; i++) {
+		model[i * 3 + 1] = i * i;
+		set_model.insert(i * 5);
+	}
+	mapped_map_int::write(path, model.begin(), model.end());
+
+	mapped_map_int					m(path);
+	std::map<int, int>::iterator	it = model.begin();
+	bool							same = m.size() == model.size();
+
+	for (mapped_map_int::const_iterator mit = m.begin(); same && mit != m.end(); mit++, it++) {
+		same = (*mit).first == it->first && (*mit).second == it->second;
+	}
+	std::cout << "mapped_map of " << n << ": size " << m.size() << ", iteration matches "
+			  << (same ? "yes" : "no") << ", lookups match "
+			  << (same_lookups(m, model, n * 3) ? "yes" : "no") << std::endl;
+
+	mapped_set_int::write(path, set_model.begin(), set_model.end());
+
+	mapped_set_int				s(path);
+	std::set<int>::iterator		sit = set_model.begin();
+
+	same = s.size() == set_model.size();
+	for (mapped_set_int::const_iterator mit = s.begin(); same && mit != s.end(); mit++, sit++) {
+		same = *mit == *sit;
+	}
+	std::cout << "mapped_set of " << n << ": size " << s.size() << ", iteration matches "
+			  << (same ? "yes" : "no") << ", lookups match "
+			  << (same_lookups(s, set_model, n * 5) ? "yes" : "no") << std::endl;
+}
+
+void	test_corrupt_mapped(char const * path, int how)
+{
+	std::map<int, int>	model;
+
+	for (int i = 0; i < 100; i++) {
+		model[i] = i;
+	}
+	mapped_map_int::write(path, model.begin(), model.end());
+	corrupt_mapped_file(path, how);
+	try {
+		mapped_map_int	m(path);
+
+		std::cout << "opened a corrupt file, size " << m.size() << std::endl;
+	}
+	catch (std::runtime_error const & e) {
+		std::cout << "Exception was caught because of a corrupt file" << std::endl;
+	}
+}
+
+// freeze() is an extension: the STL run "freezes" into a copy
+#if		STD
+template < class Container >
+Container	freeze(Container const & c)						{ return c; }
+#elif	FT
+template < class Key, class T >
+ft::frozen_map<Key, T>	freeze(ft::map<Key, T> const & m)	{ return m.freeze(); }
+template < class Key >
+ft::frozen_set<Key>		freeze(ft::set<Key> const & s)		{ return s.freeze(); }
+#endif
+
+template < class A, class B >
+bool	same_value(A const & a, B const & b)				{ return a.first == b.first && a.second == b.second; }
+bool	same_value(int a, int b)							{ return a == b; }
+
+template < class Frozen, class Model >
+bool	same_frozen(Frozen const & f, Model const & model, int max_key)
+{
+	typename Model::const_iterator	it = model.begin();
+
+	if (f.size() != model.size() || f.empty() != model.empty()) {
+		return false;
+	}
+	for (typename Frozen::const_iterator fit = f.begin(); fit != f.end(); fit++, it++) {
+		if (!same_value(*fit, *it)) {
+			return false;
+		}
+	}
+	return same_lookups(f, model, max_key);
+}
+
+void	test_freeze(int n)
+{
+	ft::map<int, int>	m;
+	ft::set<int>		s;
+	std::map<int, int>	model;
+	std::set<int>		set_model;
+
+	for (int i = 0; i < n; i++) {
+		m[i * 2 + 1] = -i;
+		model[i * 2 + 1] = -i;
+		s.insert(i * 2 + 1);
+		set_model.insert(i * 2 + 1);
+	}
+	std::cout << "size " << n << ": frozen map matches " << (same_frozen(freeze(m), model, n * 2) ? "yes" : "no")
+			  << ", frozen set matches " << (same_frozen(freeze(s), set_model, n * 2) ? "yes" : "no") << std::endl;
+}
+
+// Cursors are an extension: the STL run looks every key up from the root
+#if		STD
+template < class Container >
+class	cursor_model
+{
+	Container *		_c;
+
+	public:
+		explicit cursor_model(Container & c) : _c(&c)		{ }
+
+		typename Container::iterator	lower_bound(int key)	{ return _c->lower_bound(key); }
+		typename Container::iterator	upper_bound(int key)	{ return _c->upper_bound(key); }
+		typename Container::iterator	find(int key)			{ return _c->find(key); }
+		void							reset()					{ }
+
+		std::pair<typename Container::iterator, bool>	insert(typename Container::value_type const & value) {
+			return _c->insert(value);
+		}
+};
+
+template < class Container >
+cursor_model<Container>		get_cursor(Container & c)			{ return cursor_model<Container>(c); }
+#elif	FT
+template < class Container >
+typename Container::cursor	get_cursor(Container & c)			{ return c.get_cursor(); }
+#endif
+
+int		make_value(int key, int *)								{ return key; }
+template < class Pair >
+Pair	make_value(int key, Pair *)								{ return Pair(key, -key); }
+
+// Inserts then looks up keys in the given order through a cursor, every
+// lookup also at the gaps around the key and past both ends
+template < class Cursor, class Container, class Model >
+bool	same_cursor(Cursor cur, Container & c, Model & model, std::vector<int> const & keys)
+{
+	typedef typename Container::value_type	value_type;
+	typedef typename Container::iterator	iterator;
+
+	for (int pass = 0; pass < 2; pass++) {
+		for (size_t i = 0; i < keys.size(); i++) {
+			value_type const	value = make_value(keys[i], static_cast<value_type *>(0));
+			bool const			inserted = cur.insert(value).second;
+
+			if (inserted != model.insert(make_value(keys[i], static_cast<typename Model::value_type *>(0))).second
+				|| !same_value(*c.find(keys[i]), *model.find(keys[i]))) {
+				return false;
+			}
+		}
+	}
+	cur.reset();
+	for (size_t i = 0; i < keys.size(); i++) {
+		for (int k = keys[i] - 1; k <= keys[i] + 1; k++) {
+			iterator	found = cur.find(k);
+			long const	lower = static_cast<long>(ft::distance(c.begin(), cur.lower_bound(k)));
+			long const	upper = static_cast<long>(ft::distance(c.begin(), cur.upper_bound(k)));
+
+			if (lower != std::distance(model.begin(), model.lower_bound(k))
+				|| upper != std::distance(model.begin(), model.upper_bound(k))
+				|| (found == c.end()) != (model.find(k) == model.end())) {
+				return false;
+			}
+		}
+	}
+	return cur.lower_bound(-100) == c.begin() && cur.upper_bound(1 << 20) == c.end()
+		&& cur.find(1 << 20) == c.end() && cur.lower_bound(-1) == c.begin()
+		&& cur.find(-100) == c.end() && cur.upper_bound(-100) == c.begin();
+}
+
+void	test_cursor(std::vector<int> const & keys)
+{
+	ft::map<int, int>	m;
+	ft::set<int>		s;
+	std::map<int, int>	model;
+	std::set<int>		set_model;
+
+	std::cout << "map cursor matches " << (same_cursor(get_cursor(m), m, model, keys) ? "yes" : "no")
+			  << ", set cursor matches " << (same_cursor(get_cursor(s), s, set_model, keys) ? "yes" : "no")
+			  << ", sizes " << m.size() << ' ' << s.size() << std::endl;
+}
+
+// Hinted inserts: 0 hints with the previous insert, 1 with end(), 2 with
+// begin() and 3 with an element far from the key; each key goes in twice
+template < class Container, class Model >
+bool	same_hinted(Container & c, Model & model, std::vector<int> const & keys, int hint_kind)
+{
+	typedef typename Container::value_type	value_type;
+	typedef typename Container::iterator	iterator;
+
+	iterator	hint = c.end();
+
+	for (int pass = 0; pass < 2; pass++) {
+		for (size_t i = 0; i < keys.size(); i++) {
+			if (hint_kind == 1) {
+				hint = c.end();
+			}
+			else if (hint_kind == 2) {
+				hint = c.begin();
+			}
+			else if (hint_kind == 3) {
+				hint = c.lower_bound(keys[i] < 1500 ? 2900 : 0);
+			}
+			hint = c.insert(hint, make_value(keys[i], static_cast<value_type *>(0)));
+			model.insert(make_value(keys[i], static_cast<typename Model::value_type *>(0)));
+			if (!same_value(*hint, *model.find(keys[i]))) {
+				return false;
+			}
+		}
+	}
+
+	typename Model::const_iterator	it = model.begin();
+
+	if (c.size() != model.size()) {
+		return false;
+	}
+	for (typename Container::const_iterator cit = c.begin(); cit != c.end(); cit++, it++) {
+		if (!same_value(*cit, *it)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void	test_hinted(std::vector<int> const & keys)
+{
+	char const *	hints[] = { "previous", "end()", "begin()", "far" };
+
+	for (int kind = 0; kind < 4; kind++) {
+		ft::map<int, int>	m;
+		ft::set<int>		s;
+		std::map<int, int>	model;
+		std::set<int>		set_model;
+		bool const			map_ok = same_hinted(m, model, keys, kind);
+		bool const			set_ok = same_hinted(s, set_model, keys, kind);
+
+		std::cout << "hint " << hints[kind] << ": map matches " << (map_ok ? "yes" : "no")
+				  << ", set matches " << (set_ok ? "yes" : "no") << std::endl;
+	}
+}
+
+// Bulk loads are an extension: the STL run inserts the input in order,
+// which keeps the first of equal keys as well
+#if		STD
+struct	bulk_pool
+{
+	explicit bulk_pool(size_t)	{ }
+};
+
+template < class Container, class InputIterator >
+void	bulk_load(bulk_pool &, Container & c, InputIterator first, InputIterator last)
+{
+	c.clear();
+	c.insert(first, last);
+}
+#elif	FT
+typedef ft::thread_pool		bulk_pool;
+#endif
+
+// Same elements in both directions, begin() == end() exactly when empty
+template < class Container, class Model >
+bool	same_contents(Container const & c, Model const & model)
+{
+	typename Container::const_iterator	cit = c.begin();
+	typename Model::const_iterator		it = model.begin();
+
+	if (c.size() != model.size() || (c.begin() == c.end()) != model.empty()) {
+		return false;
+	}
+	for (; cit != c.end(); cit++, it++) {
+		if (!same_value(*cit, *it)) {
+			return false;
+		}
+	}
+	while (cit != c.begin()) {
+		if (!same_value(*--cit, *--it)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// n shuffled even keys, about half of them repeated with other values;
+// the containers start out with a key the input lacks. Odd keys are then
+// inserted and every third key erased, which rebalances the loaded tree
+void	test_bulk_load(bulk_pool & pool, int n)
+{
+	std::vector< ft::pair<int, int> >	input;
+	std::vector<int>					set_input;
+	unsigned							seed = 777 + n;
+
+	for (int i = 0; i < n; i++) {
+		seed = seed * 1103515245 + 12345;
+
+		int const	key = static_cast<int>((seed >> 8) % (n / 2 + 1)) * 2;
+
+		input.push_back(ft::make_pair(key, i));
+		set_input.push_back(key);
+	}
+
+	ft::map<int, int>	m;
+	ft::set<int>		s;
+	std::map<int, int>	model;
+	std::set<int>		set_model;
+
+	m[-1] = -1;
+	s.insert(-1);
+	bulk_load(pool, m, input.begin(), input.end());
+	bulk_load(pool, s, set_input.begin(), set_input.end());
+	for (int i = 0; i < n; i++) {
+		model.insert(std::make_pair(input[i].first, input[i].second));
+		set_model.insert(set_input[i]);
+	}
+	std::cout << "size " << n << " (" << m.size() << " keys): map matches "
+			  << (same_contents(m, model) ? "yes" : "no")
+			  << ", set matches " << (same_contents(s, set_model) ? "yes" : "no");
+
+	for (int i = 0; i < n; i++) {
+		m.insert(ft::make_pair(i * 2 + 1, -i));
+		model.insert(std::make_pair(i * 2 + 1, -i));
+		s.insert(i * 2 + 1);
+		set_model.insert(i * 2 + 1);
+	}
+	for (int k = 0; k < n; k += 3) {
+		m.erase(k);
+		model.erase(k);
+		s.erase(k);
+		set_model.erase(k);
+	}
+	std::cout << ", after inserts and erases " << (same_contents(m, model) && same_contents(s, set_model) ? "yes" : "no")
+			  << std::endl;
+}
+
+// The STL has no indexed queue: the model keeps (value, handle) pairs in a
+// multiset and the values by handle, and reuses the last freed handle first
+class	indexed_queue_model
+{
+	std::multiset< std::pair<int, size_t> >	_entries;
+	std::vector<int>						_values;
+	std::vector<bool>						_used;
+	std::vector<size_t>						_free;
+
+	public:
+		typedef size_t	handle_type;
+
+		bool		empty() const				{ return _entries.empty(); }
+		size_t		size() const				{ return _entries.size(); }
+		int			top() const					{ return _entries.rbegin()->first; }
+		size_t		top_handle() const			{ return _entries.rbegin()->second; }
+		bool		contains(size_t h) const	{ return h < _used.size() && _used[h]; }
+
+		int			value(size_t h) const		{ _check(h); return _values[h]; }
+
+		size_t		push(int value)
+		{
+			if (_free.empty()) {
+				_free.push_back(_used.size());
+				_values.push_back(0);
+				_used.push_back(false);
+			}
+
+			size_t const	h = _free.back();
+
+			_free.pop_back();
+			_values[h] = value;
+			_used[h] = true;
+			_entries.insert(std::make_pair(value, h));
+			return h;
+		}
+
+		void		pop()						{ erase(top_handle()); }
+
+		void		erase(size_t h)
+		{
+			_check(h);
+			_entries.erase(_entries.find(std::make_pair(_values[h], h)));
+			_used[h] = false;
+			_free.push_back(h);
+		}
+
+		void		update(size_t h, int value)
+		{
+			_check(h);
+			_entries.erase(_entries.find(std::make_pair(_values[h], h)));
+			_values[h] = value;
+			_entries.insert(std::make_pair(value, h));
+		}
+
+		void		decrease_key(size_t h, int value)	{ update(h, value); }
+
+		void		clear()
+		{
+			_entries.clear();
+			_values.clear();
+			_used.clear();
+			_free.clear();
+		}
+
+	private:
+		void		_check(size_t h) const
+		{
+			if (!contains(h)) {
+				throw std::out_of_range("indexed_queue_model::out_of_range");
+			}
+		}
+};
+
+#if		STD
+typedef indexed_queue_model					indexed_queue_int;
+#elif	FT
+typedef ft::indexed_priority_queue<int>		indexed_queue_int;
+#endif
+
+template < class Queue >
+bool	same_queue(Queue const & q, indexed_queue_model const & model)
+{
+	return q.size() == model.size() && q.empty() == model.empty()
+		&& (q.empty() || (q.top() == model.top() && q.top_handle() == model.top_handle()));
+}
+
+// Handles of q and model used on a handle that is not live, all must throw
+template < class Queue >
+int		out_of_range_count(Queue & q, indexed_queue_model & model, size_t h)
+{
+	int		thrown = 0;
+
+	for (int op = 0; op < 4; op++) {
+		for (int which = 0; which < 2; which++) {
+			try {
+				if (op == 0) {
+					which ? q.erase(h) : model.erase(h);
+				}
+				else if (op == 1) {
+					which ? q.update(h, 1) : model.update(h, 1);
+				}
+				else if (op == 2) {
+					which ? q.decrease_key(h, 1) : model.decrease_key(h, 1);
+				}
+				else {
+					int const	ignored = which ? q.value(h) : model.value(h);
+
+					(void)ignored;
+				}
+			}
+			catch (std::out_of_range const &) {
+				thrown++;
+			}
+		}
+	}
+	return thrown;
+}
+
+// Random pushes, pops, erases, updates and decrease_keys, both raising and
+// lowering priorities. Values are distinct (key * 4096 + step), so the top
+// and the handle freed by a pop do not depend on the heap layout
+void	test_indexed_queue(int steps)
+{
+	indexed_queue_int		q;
+	indexed_queue_model		model;
+	std::vector<size_t>		live;
+	unsigned				seed = 99;
+	bool					same = true;
+	int						counts[7] = { 0 };
+	int						thrown = 0;
+	int						reused = 0;
+	size_t					issued = 0;
+
+	for (int i = 0; i < steps && same; i++) {
+		seed = seed * 1103515245 + 12345;
+
+		int const		op = live.empty() ? 0 : static_cast<int>((seed >> 8) % 8);
+		size_t const	pick = live.empty() ? 0 : (seed >> 12) % live.size();
+		int const		value = static_cast<int>((seed >> 16) % 1000) * 4096 + i;
+
+		if (op <= 2) {
+			size_t const	h = q.push(value);
+
+			same = h == model.push(value) && q.contains(h) && q.value(h) == value;
+			reused += h < issued;
+			issued = std::max(issued, h + 1);
+			live.push_back(h);
+			counts[0]++;
+		}
+		else if (op == 3 || op == 4) {
+			size_t const	h = op == 3 ? q.top_handle() : live[pick];
+
+			if (op == 3) {
+				q.pop();
+				model.pop();
+				live.erase(std::find(live.begin(), live.end(), h));
+			}
+			else {
+				q.erase(h);
+				model.erase(h);
+				live.erase(live.begin() + pick);
+			}
+			same = !q.contains(h);
+			thrown += out_of_range_count(q, model, h);
+			counts[op - 2]++;
+		}
+		else {
+			size_t const	h = live[pick];
+			bool const		rises = value > q.value(h);
+
+			if (op == 5) {
+				q.update(h, value);
+				model.update(h, value);
+			}
+			else {
+				q.decrease_key(h, value);
+				model.decrease_key(h, value);
+			}
+			same = q.value(h) == value;
+			counts[op == 5 ? 3 + !rises : 5 + !rises]++;
+		}
+		same = same && same_queue(q, model);
+	}
+	thrown += out_of_range_count(q, model, issued + 1000);
+
+	std::cout << steps << " steps: matches " << (same ? "yes" : "no")
+			  << ", pushes " << counts[0] << " (" << reused << " reused handles), pops " << counts[1]
+			  << ", erases " << counts[2] << ", updates up/down " << counts[3] << '/' << counts[4]
+			  << ", decrease_key up/down " << counts[5] << '/' << counts[6]
+			  << ", out_of_range " << thrown << std::endl;
+
+	print_testing("Testing draining in order:");
+	while (same && !q.empty()) {
+		same = same_queue(q, model);
+		q.pop();
+		model.pop();
+	}
+	q.clear();
+	model.clear();
+	same = same && same_queue(q, model) && q.push(7) == model.push(7) && same_queue(q, model);
+	std::cout << "matches " << (same ? "yes" : "no") << ", first handle after clear " << q.top_handle() << std::endl;
+}
+
 int main(int argc, char** argv) {
 	std::cout	<< ITALIC << GREEN
 				<< "Running tests in \"main.cpp\" from intra subject."
@@ -80,7 +1232,7 @@ int main(int argc, char** argv) {
 	ft::vector<int> vector_int;
 	ft::stack<int> stack_int;
 	ft::vector<Buffer> vector_buffer;
-	ft::stack<Buffer, std::deque<Buffer> > stack_deq_buffer;
+	ft::stack<Buffer, ft::deque<Buffer> > stack_deq_buffer;
 	ft::map<int, int> map_int;
 
 	for (int i = 0; i < COUNT; i++)
@@ -274,14 +1426,46 @@ int main(int argc, char** argv) {
 	std::cout << "operator >= " << (v_test >= v_salam ? "true" : "false") << std::endl;
 	std::cout << "operator > " << (v_test > v_tmp ? "true" : "false") << std::endl;
 	std::cout << "operator >= " << (v_test >= v_tmp ? "true" : "false") << std::endl;
+	print_testing("Testing the default_init constructor and data():");
+	ft::vector<int>	v_raw = make_default_init<ft::vector<int> >(64);
+	std::cout << "v_raw.size() = " << v_raw.size() << std::endl;
+	std::cout << "data() == &v_raw[0]: " << (v_raw.data() == &v_raw[0] ? "yes" : "no") << std::endl;
+	for (int i = 0; i < 64; i++) {
+		v_raw.data()[i] = i * i;
+	}
+	std::cout << "v_raw[9] = " << v_raw[9] << ", v_raw[63] = " << v_raw[63] << std::endl;
+	print_testing("Testing resize_default_init():");
+	resize_default_init(v_raw, 40);
+	print_vector(v_raw);
+	resize_default_init(v_raw, 300);
+	std::cout << "v_raw.size() = " << v_raw.size() << std::endl;
+	for (int i = 0; i < 40; i++) {
+		std::cout << v_raw[i] << ' ';
+	}
+	std::cout << std::endl;
+	std::cout << "data() == &v_raw[0]: " << (v_raw.data() == &v_raw[0] ? "yes" : "no") << std::endl;
+	std::cout << "data() + 299 == &v_raw.back(): " << (v_raw.data() + 299 == &v_raw.back() ? "yes" : "no") << std::endl;
+	ft::vector<std::string>	v_strs(3, "kept");
+	resize_default_init(v_strs, 5);
+	ft::vector<std::string> const &	v_strs_ref = v_strs;
+	for (size_t i = 0; i < v_strs_ref.size(); i++) {
+		std::cout << '"' << v_strs_ref.data()[i] << "\" ";
+	}
+	std::cout << std::endl;
+	ft::vector<std::string>	v_strs_raw = make_default_init<ft::vector<std::string> >(2);
+	std::cout << "v_strs_raw: \"" << v_strs_raw[0] << "\" \"" << v_strs_raw[1] << '"' << std::endl;
+	test_growth<vector_growth_double>("growth_double");
+	test_growth<vector_growth_golden>("growth_golden");
+	test_growth<vector_growth_page_rounded>("growth_page_rounded");
+	test_growth<vector_growth_size_class>("growth_size_class");
 
 	std::cout	<< std::endl
 				<< ITALIC << GREEN
 				<< "Running stack tests."
 				<< RESET << std::endl;
 
-	ft::stack<int, std::deque<int> >	st_test;
-	print_testing("Stack was created with std::deque container");
+	ft::stack<int, ft::deque<int> >	st_test;
+	print_testing("Stack was created with deque container");
 	print_testing("Testing capacity methods:");
 	std::cout << "st_test.empty(): " << (st_test.empty() ? "yes" : "no") << std::endl;
 	std::cout << "st_test.size() = " << st_test.size() << std::endl;
@@ -300,6 +1484,121 @@ int main(int argc, char** argv) {
 	std::cout << "st_test.size() = " << st_test.size() << std::endl;
 	std::cout << "st_test.empty(): " << (st_test.empty() ? "yes" : "no") << std::endl;
 
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running queue tests."
+				<< RESET << std::endl;
+
+	ft::queue<int>	q_test;
+	print_testing("Testing capacity methods:");
+	std::cout << "q_test.empty(): " << (q_test.empty() ? "yes" : "no") << std::endl;
+	std::cout << "q_test.size() = " << q_test.size() << std::endl;
+	print_testing("Testing push() and size() again:");
+	for (int i = 1; i < 4243; i++) {
+		q_test.push(i);
+	}
+	std::cout << "q_test.size() = " << q_test.size() << std::endl;
+	print_testing("Testing front() and back():");
+	std::cout << "q_test.front() = " << q_test.front() << ", q_test.back() = " << q_test.back() << std::endl;
+	print_testing("Testing pop():");
+	for (int i = 0; i < 4200; i++) {
+		q_test.pop();
+	}
+	std::cout << "q_test.front() = " << q_test.front() << ", q_test.back() = " << q_test.back() << std::endl;
+	std::cout << "q_test.size() = " << q_test.size() << std::endl;
+	print_testing("Testing operator overloads:");
+	ft::queue<int>	q_copy(q_test);
+	std::cout << "operator == " << (q_test == q_copy ? "true" : "false") << std::endl;
+	q_copy.pop();
+	std::cout << "operator != " << (q_test != q_copy ? "true" : "false") << std::endl;
+	std::cout << "operator < " << (q_test < q_copy ? "true" : "false") << std::endl;
+	std::cout << "operator >= " << (q_test >= q_copy ? "true" : "false") << std::endl;
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running priority_queue tests."
+				<< RESET << std::endl;
+
+	ft::priority_queue<int>	pq_test;
+	print_testing("Testing capacity methods:");
+	std::cout << "pq_test.empty(): " << (pq_test.empty() ? "yes" : "no") << std::endl;
+	std::cout << "pq_test.size() = " << pq_test.size() << std::endl;
+	print_testing("Testing push() and top():");
+	for (int i = 0; i < 4242; i++) {
+		pq_test.push(i * 7919 % 4243);
+	}
+	std::cout << "pq_test.size() = " << pq_test.size() << std::endl;
+	std::cout << "pq_test.top() = " << pq_test.top() << std::endl;
+	print_testing("Testing pop():");
+	for (int i = 0; i < 4200; i++) {
+		pq_test.pop();
+	}
+	std::cout << "pq_test.top() = " << pq_test.top() << std::endl;
+	std::cout << "pq_test.size() = " << pq_test.size() << std::endl;
+	print_testing("Testing range constructor and greater:");
+	ft::vector<int>	pq_input;
+	for (int i = 0; i < 100; i++) {
+		pq_input.push_back((i * 37) % 101 - 50);
+	}
+	ft::priority_queue<int, ft::vector<int>, ft::greater<int> >	pq_min(pq_input.begin(), pq_input.end());
+	std::cout << "pq_min:";
+	while (!pq_min.empty()) {
+		std::cout << " " << pq_min.top();
+		pq_min.pop();
+	}
+	std::cout << std::endl;
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running deque tests."
+				<< RESET << std::endl;
+
+	ft::deque<int>	d_test;
+	typedef ft::deque<int>::iterator	d_iter;
+	print_testing("Testing push_front() and push_back():");
+	for (int i = 0; i < 4242; i++) {
+		d_test.push_back(i);
+		d_test.push_front(-i);
+	}
+	std::cout << "d_test.size() = " << d_test.size() << std::endl;
+	std::cout << "d_test.front() = " << d_test.front() << ", d_test.back() = " << d_test.back() << std::endl;
+	print_testing("Testing pop_front() and pop_back():");
+	for (int i = 0; i < 4200; i++) {
+		d_test.pop_front();
+		d_test.pop_back();
+	}
+	for (d_iter it = d_test.begin(); it != d_test.end(); it++) {
+		std::cout << *it << ' ';
+	}
+	std::cout << std::endl;
+	print_testing("Testing operator[] and at():");
+	for (size_t i = 0; i < d_test.size(); i += 7) {
+		std::cout << d_test[i] << ' ' << d_test.at(i) << ' ';
+	}
+	std::cout << std::endl;
+	try {
+		d_test.at(4242);
+	}
+	catch (std::exception const & e) {
+		std::cout << "Exception was caught because of a range error from at()" << std::endl;
+	}
+	print_testing("Testing insert() and erase():");
+	d_test.insert(d_test.begin() + 3, 3, 21);
+	d_test.insert(d_test.end() - 5, 42);
+	d_test.erase(d_test.begin() + 10, d_test.begin() + 20);
+	d_test.erase(d_test.begin());
+	for (ft::deque<int>::reverse_iterator rit = d_test.rbegin(); rit != d_test.rend(); rit++) {
+		std::cout << *rit << ' ';
+	}
+	std::cout << std::endl;
+	std::cout << "d_test.size() = " << d_test.size() << std::endl;
+	ft::deque<int>	d_copy(d_test);
+	print_testing("Testing operator overloads:");
+	std::cout << "operator == " << (d_test == d_copy ? "true" : "false") << std::endl;
+	d_copy.push_front(0);
+	std::cout << "operator < " << (d_test < d_copy ? "true" : "false") << std::endl;
+	std::cout << "operator >= " << (d_test >= d_copy ? "true" : "false") << std::endl;
+
 	std::cout	<< std::endl
 				<< ITALIC << GREEN
 				<< "Running map tests."
@@ -374,6 +1673,24 @@ int main(int argc, char** argv) {
 	std::cout << "operator <= " << (m_test <= m_copy ? "true" : "false") << std::endl;
 	std::cout << "operator > " << (m_test > m_copy ? "true" : "false") << std::endl;
 	std::cout << "operator >= " << (m_test >= m_copy ? "true" : "false") << std::endl;
+	print_testing("Testing erase() over long ranges, erase_below() and erase_above():");
+	ft::map<int, int>	m_range;
+	for (int i = 0; i < 3000; i++) {
+		m_range.insert(ft::make_pair((i * 7919) % 3000 * 2, i));
+	}
+	m_range.erase(m_range.lower_bound(700), m_range.lower_bound(4900));
+	m_range.erase(m_range.lower_bound(5000), m_range.upper_bound(5015));
+	print_map(m_range);
+	erase_below(m_range, 101);
+	erase_above(m_range, 5600);
+	print_map(m_range);
+	erase_below(m_range, 0);
+	erase_above(m_range, 6000);
+	erase_above(m_range, 300);
+	erase_below(m_range, 250);
+	print_map(m_range);
+	erase_below(m_range, 6000);
+	std::cout << "m_range.empty() after erase_below(6000): " << (m_range.empty() ? "yes" : "no") << std::endl;
 
 	std::cout	<< std::endl
 				<< ITALIC << GREEN
@@ -437,6 +1754,338 @@ int main(int argc, char** argv) {
 	std::cout << "operator <= " << (s_test <= s_copy ? "true" : "false") << std::endl;
 	std::cout << "operator > " << (s_test > s_copy ? "true" : "false") << std::endl;
 	std::cout << "operator >= " << (s_test >= s_copy ? "true" : "false") << std::endl;
+	print_testing("Testing erase_below() and erase_above():");
+	ft::set<int>	s_range;
+	for (int i = 0; i < 500; i++) {
+		s_range.insert(i * 3);
+	}
+	erase_below(s_range, 100);
+	erase_above(s_range, 1300);
+	std::cout << "s_range.size() = " << s_range.size() << ", front " << *s_range.begin()
+			  << ", back " << *s_range.rbegin() << std::endl;
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running small_vector tests."
+				<< RESET << std::endl;
+
+	small_vector_int	sv_int;
+	int const			sv_range[] = { 100, 200, 300, 400 };
+
+	print_testing("Testing push_back() into the inline buffer and past it:");
+	for (int i = 0; i < 8; i++) {
+		sv_int.push_back(i * 3);
+	}
+	std::cout << "8 elements, inline: " << (is_inline(sv_int) ? "yes" : "no") << std::endl;
+	for (int i = 8; i < 20; i++) {
+		sv_int.push_back(i * 3);
+	}
+	std::cout << "20 elements, inline: " << (is_inline(sv_int) ? "yes" : "no") << std::endl;
+	print_vector(sv_int);
+	print_testing("Testing insert() and erase():");
+	sv_int.insert(sv_int.begin() + 3, 42);
+	sv_int.insert(sv_int.begin(), 3, -1);
+	sv_int.insert(sv_int.end() - 2, sv_range, sv_range + 4);
+	sv_int.erase(sv_int.begin() + 5);
+	sv_int.erase(sv_int.begin() + 2, sv_int.begin() + 10);
+	print_vector(sv_int);
+	print_testing("Testing pop_back() and resize():");
+	sv_int.pop_back();
+	sv_int.resize(6);
+	print_vector(sv_int);
+	std::cout << "inline: " << (is_inline(sv_int) ? "yes" : "no") << std::endl;
+	print_testing("Testing shrink_to_fit() back into the inline buffer:");
+	shrink_to_fit(sv_int);
+	std::cout << "inline: " << (is_inline(sv_int) ? "yes" : "no") << std::endl;
+	print_vector(sv_int);
+	sv_int.resize(12, 7);
+	std::cout << "resize(12, 7), inline: " << (is_inline(sv_int) ? "yes" : "no") << std::endl;
+	print_testing("Testing copy constructor and swap():");
+	small_vector_int	sv_copy(sv_int);
+	small_vector_int	sv_small(3, 9);
+	sv_copy.swap(sv_small);
+	print_vector(sv_copy);
+	std::cout << "inline: " << (is_inline(sv_copy) ? "yes" : "no") << std::endl;
+	print_vector(sv_small);
+	std::cout << "inline: " << (is_inline(sv_small) ? "yes" : "no") << std::endl;
+	std::cout << "operator == " << (sv_small == sv_int ? "true" : "false") << std::endl;
+	try {
+		print_testing("Testing .at() method:");
+		std::cout << sv_int.at(11) << std::endl;
+		std::cout << sv_int.at(12) << std::endl;
+	}
+	catch (std::exception const & e) {
+		std::cout << "Exception was caught because of a range error from at()" << std::endl;
+	}
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running static_vector tests."
+				<< RESET << std::endl;
+
+	static_vector_int	st_int;
+	int const			st_range[] = { -7, -8 };
+
+	print_testing("Testing push_back() up to the capacity:");
+	for (int i = 0; i < 8; i++) {
+		push_back_bounded(st_int, i * i);
+	}
+	print_vector(st_int);
+	try {
+		print_testing("Testing push_back() past the capacity:");
+		push_back_bounded(st_int, 64);
+	}
+	catch (std::length_error const & e) {
+		std::cout << "Exception was caught because of a length error from push_back()" << std::endl;
+	}
+	print_vector(st_int);
+	print_testing("Testing insert() and erase():");
+	st_int.erase(st_int.begin() + 2, st_int.begin() + 5);
+	st_int.insert(st_int.begin() + 1, 2, -4);
+	st_int.erase(st_int.begin());
+	st_int.insert(st_int.end() - 1, st_range, st_range + 2);
+	print_vector(st_int);
+	print_testing("Testing pop_back() and resize():");
+	st_int.pop_back();
+	st_int.resize(4);
+	print_vector(st_int);
+	st_int.resize(7, 1);
+	print_vector(st_int);
+	print_testing("Testing copy constructor and swap():");
+	static_vector_int	st_copy(st_int);
+	static_vector_int	st_other(2, 5);
+	st_copy.swap(st_other);
+	print_vector(st_copy);
+	print_vector(st_other);
+	std::cout << "operator == " << (st_other == st_int ? "true" : "false") << std::endl;
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running segmented_vector tests."
+				<< RESET << std::endl;
+
+	segmented_vector_int	sg_int;
+	int const				sg_range[] = { 11, 22, 33, 44, 55, 66 };
+
+	print_testing("Testing push_back() across chunks:");
+	for (int i = 0; i < 22; i++) {
+		sg_int.push_back(i * 5);
+	}
+	print_vector(sg_int);
+	print_testing("Testing reverse_iterator:");
+	for (segmented_vector_int::reverse_iterator rit = sg_int.rbegin(); rit != sg_int.rend(); rit++) {
+		std::cout << *rit << ' ';
+	}
+	std::cout << std::endl;
+	try {
+		print_testing("Testing .at() method:");
+		std::cout << sg_int.at(4) << std::endl;
+		std::cout << sg_int.at(21) << std::endl;
+		std::cout << sg_int.at(22) << std::endl;
+	}
+	catch (std::exception const & e) {
+		std::cout << "Exception was caught because of a range error from at()" << std::endl;
+	}
+	std::cout << CYAN << "Testing front() and back(): " << RESET << sg_int.front() << " and " << sg_int.back() << std::endl;
+	print_testing("Testing pop_back(), resize() and shrink_to_fit():");
+	for (int i = 0; i < 5; i++) {
+		sg_int.pop_back();
+	}
+	print_vector(sg_int);
+	sg_int.resize(30, -1);
+	print_vector(sg_int);
+	sg_int.resize(3);
+	shrink_to_fit(sg_int);
+	print_vector(sg_int);
+	print_testing("Testing assign():");
+	sg_int.assign(sg_range, sg_range + 6);
+	print_vector(sg_int);
+	sg_int.assign(9, 8);
+	print_vector(sg_int);
+	print_testing("Testing copy constructor and swap():");
+	segmented_vector_int	sg_copy(sg_int);
+	segmented_vector_int	sg_other(sg_range, sg_range + 5);
+	sg_copy.swap(sg_other);
+	print_vector(sg_copy);
+	print_vector(sg_other);
+	std::cout << "operator == " << (sg_other == sg_int ? "true" : "false") << std::endl;
+	print_testing("Testing clear():");
+	sg_int.clear();
+	std::cout << "sg_int.empty(): " << (sg_int.empty() ? "yes" : "no") << std::endl;
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running multimap tests."
+				<< RESET << std::endl;
+
+	ft::multimap<int, int>	mm_test;
+	test_multimap(mm_test);
+	print_testing("Testing erase_below() and erase_above():");
+	erase_below(mm_test, 4);
+	erase_above(mm_test, 30);
+	print_map(mm_test);
+	print_testing("Testing grouped_multimap:");
+	grouped_multimap_int	gmm_test;
+	test_multimap(gmm_test);
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running multiset tests."
+				<< RESET << std::endl;
+
+	ft::multiset<int>	ms_test;
+	test_multiset(ms_test);
+	print_testing("Testing erase_below() and erase_above():");
+	erase_below(ms_test, 4);
+	erase_above(ms_test, 25);
+	print_set(ms_test);
+	print_testing("Testing grouped_multiset:");
+	grouped_multiset_int	gms_test;
+	test_multiset(gms_test);
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running huge_page_allocator tests."
+				<< RESET << std::endl;
+
+	huge_page_vector_int	hp_vector;
+	huge_page_map_int		hp_map;
+	test_allocated(hp_vector, hp_map);
+	print_testing("Testing with a 4 KB threshold:");
+	huge_page_small_vector_int	hp_small;
+	huge_page_map_int			hp_map2;
+	test_allocated(hp_small, hp_map2);
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running memory_resource tests."
+				<< RESET << std::endl;
+
+	print_testing("Testing monotonic_buffer_resource:");
+	test_memory_resource(0);
+	print_testing("Testing monotonic_buffer_resource on a stack buffer:");
+	test_memory_resource(1);
+	print_testing("Testing unsynchronized_pool_resource:");
+	test_memory_resource(2);
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running mmap_vector tests."
+				<< RESET << std::endl;
+
+	char	mmap_path[] = "/tmp/ft_mmap_vector.XXXXXX";
+	int		mmap_fd = mkstemp(mmap_path);
+
+	if (mmap_fd >= 0) {
+		close(mmap_fd);
+		test_mmap_vector(mmap_path);
+		unlink(mmap_path);
+	}
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running mapped_map and mapped_set tests."
+				<< RESET << std::endl;
+
+	char	mapped_path[] = "/tmp/ft_mapped.XXXXXX";
+	int		mapped_fd = mkstemp(mapped_path);
+
+	if (mapped_fd >= 0) {
+		close(mapped_fd);
+		print_testing("Testing empty, single-stride and multi-stride files:");
+		test_mapped(mapped_path, 0);
+		test_mapped(mapped_path, 1);
+		test_mapped(mapped_path, 63);
+		test_mapped(mapped_path, 64);
+		test_mapped(mapped_path, 65);
+		test_mapped(mapped_path, 1000);
+		print_testing("Testing a truncated header, truncated values and a bad magic:");
+		test_corrupt_mapped(mapped_path, 0);
+		test_corrupt_mapped(mapped_path, 1);
+		test_corrupt_mapped(mapped_path, 2);
+		unlink(mapped_path);
+	}
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running freeze() tests."
+				<< RESET << std::endl;
+
+	print_testing("Testing sizes 0, 1 and around powers of two:");
+	test_freeze(0);
+	test_freeze(1);
+	for (int k = 1; k <= 8; k++) {
+		test_freeze((1 << k) - 1);
+		test_freeze(1 << k);
+		test_freeze((1 << k) + 1);
+	}
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running cursor tests."
+				<< RESET << std::endl;
+
+	std::vector<int>	cursor_keys;
+	unsigned			cursor_seed = 12345;
+
+	for (int i = 0; i < 1000; i++) {
+		cursor_keys.push_back(i * 3);
+	}
+	print_testing("Testing ascending keys:");
+	test_cursor(cursor_keys);
+	print_testing("Testing descending keys:");
+	std::reverse(cursor_keys.begin(), cursor_keys.end());
+	test_cursor(cursor_keys);
+	print_testing("Testing random keys:");
+	for (size_t i = cursor_keys.size() - 1; i > 0; i--) {
+		cursor_seed = cursor_seed * 1103515245 + 12345;
+		std::swap(cursor_keys[i], cursor_keys[(cursor_seed >> 8) % (i + 1)]);
+	}
+	test_cursor(cursor_keys);
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running hinted insert tests."
+				<< RESET << std::endl;
+
+	std::vector<int>	hinted_keys;
+
+	for (int i = 0; i < 1000; i++) {
+		hinted_keys.push_back(i * 3);
+	}
+	print_testing("Testing sorted keys:");
+	test_hinted(hinted_keys);
+	print_testing("Testing nearly sorted keys:");
+	for (size_t i = 0; i + 1 < hinted_keys.size(); i += 7) {
+		std::swap(hinted_keys[i], hinted_keys[i + 1]);
+	}
+	test_hinted(hinted_keys);
+	print_testing("Testing reverse sorted keys:");
+	std::sort(hinted_keys.begin(), hinted_keys.end());
+	std::reverse(hinted_keys.begin(), hinted_keys.end());
+	test_hinted(hinted_keys);
+	print_testing("Testing random keys:");
+	test_hinted(cursor_keys);
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running bulk_load tests."
+				<< RESET << std::endl;
+
+	bulk_pool	pool(4);
+	int const	bulk_sizes[] = { 0, 1, 2, 3, 100, 4095, 4096, 4097, 20000 };
+
+	for (size_t i = 0; i < sizeof(bulk_sizes) / sizeof(*bulk_sizes); i++) {
+		test_bulk_load(pool, bulk_sizes[i]);
+	}
+
+	std::cout	<< std::endl
+				<< ITALIC << GREEN
+				<< "Running indexed_priority_queue tests."
+				<< RESET << std::endl;
+
+	print_testing("Testing random operations:");
+	test_indexed_queue(3000);
 
 	return (0);
 }
@@ -4,6 +4,7 @@
 # include <memory>
 
 # include "RBtree.hpp"
+# include "frozen_map.hpp"
 # include "utils.hpp"
 
 namespace	ft
@@ -59,6 +60,9 @@ class	map
 
 		tree_type		_tree;
 
+	public:
+		typedef typename tree_type::template cursor<iterator>	cursor;
+
 	// Constructors
 	public:
 		explicit map (key_compare const & comp = key_compare(),
@@ -134,10 +138,36 @@ class	map
 		size_type		erase(key_type const & key)				{ return _tree.erase(key); }
 		void			erase(iterator first, iterator last)	{ return _tree.erase(first, last); }
 
+		void			erase_below(key_type const & key)		{ _tree.erase_below(key); }
+		void			erase_above(key_type const & key)		{ _tree.erase_above(key); }
 		void			clear()									{ _tree.clear(); }
 
 		void			swap(map & m)							{ _tree.swap(m._tree); }
 
+		// Immutable copy with a pointer-free, cache friendly search layout
+		frozen_map<Key, T, Compare, Allocator>	freeze() const
+		{
+			return frozen_map<Key, T, Compare, Allocator>(begin(), end(), size(), key_comp(), get_allocator());
+		}
+
+		// Lookups and inserts through the cursor start from its last position
+		cursor			get_cursor()							{ return cursor(_tree); }
+
+		// Parallel building blocks of ft::bulk_load and ft::parallel_for_each,
+		// see parallel_map.hpp and RedBlackTree::assign_sorted_unique
+		template < class ForBlocks >
+		void			assign_sorted_unique(value_type const * const * values, size_type count,
+											 ForBlocks for_blocks)
+		{
+			_tree.assign_sorted_unique(values, count, for_blocks);
+		}
+
+		template < class ForBlocks, class Function >
+		void			parallel_for_each(ForBlocks for_blocks, Function f) const	{ _tree.parallel_for_each(for_blocks, f); }
+
+		template < class ForBlocks, class Function >
+		void			parallel_for_each(ForBlocks for_blocks, Function f)		{ _tree.parallel_for_each(for_blocks, f); }
+
 	// Observers
 		allocator_type	get_allocator() const					{ return _tree.get_allocator(); }
 		key_compare		key_comp() const						{ return _tree.key_comp(); }
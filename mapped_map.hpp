@@ -0,0 +1,151 @@
+#ifndef FT_MAPPED_MAP_HPP
+# define FT_MAPPED_MAP_HPP
+
+# include "mapped_tree.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+// Plain key/value record stored in mapped_map files; unlike ft::pair it is
+// trivially copyable, so it can be written and mapped byte for byte
+template < class Key, class T >
+struct	mapped_pair
+{
+	typedef Key		first_type;
+	typedef T		second_type;
+
+	Key				first;
+	T				second;
+};
+
+// Read-only ft::map served straight from a file written by mapped_map::write;
+// opening it maps the file, lookups and iteration read the mapping in place
+template	<	class Key,
+				class T,
+				class Compare = less<Key>
+			>
+class	mapped_map
+{
+	// Type definitions
+	public:
+		typedef Key											key_type;
+		typedef T											mapped_type;
+		typedef mapped_pair<key_type, mapped_type>			value_type;
+		typedef Compare										key_compare;
+
+	private:
+		typedef mapped::sorted_file <	key_type,
+										value_type,
+										select1st<value_type>,
+										key_compare	>		file_type;
+
+	public:
+		typedef typename file_type::size_type				size_type;
+		typedef typename file_type::difference_type			difference_type;
+		typedef typename file_type::reference				reference;
+		typedef typename file_type::const_reference			const_reference;
+		typedef typename file_type::pointer					pointer;
+		typedef typename file_type::const_pointer			const_pointer;
+		typedef typename file_type::iterator				iterator;
+		typedef typename file_type::const_iterator			const_iterator;
+		typedef typename file_type::reverse_iterator		reverse_iterator;
+		typedef typename file_type::const_reverse_iterator	const_reverse_iterator;
+
+	// File
+	private:
+		file_type		_file;
+
+	// Constructors
+	public:
+		explicit mapped_map (key_compare const & comp = key_compare())
+			: _file(comp)									{ }
+
+		explicit mapped_map (char const * path, key_compare const & comp = key_compare())
+			: _file(comp)
+		{
+			_file.open(path);
+		}
+
+		~mapped_map ()										{ }
+
+	// File
+		void			open(char const * path)					{ _file.open(path); }
+		void			close()									{ _file.close(); }
+		bool			is_open() const							{ return _file.is_open(); }
+		void			advise(int advice) const				{ _file.advise(advice); }
+
+		// Writes [first, last), sorted and unique by key as iterating an
+		// ft::map yields them, in the format open() maps
+		template < class InputIterator >
+		static void		write(char const * path, InputIterator first, InputIterator last,
+							  key_compare const & comp = key_compare())
+		{
+			typename file_type::writer	w(path, comp);
+			value_type					v;
+
+			for (; first != last; ++first) {
+				v.first = (*first).first;
+				v.second = (*first).second;
+				w.append(v);
+			}
+			w.finish();
+		}
+
+		template < class Map >
+		static void		write(char const * path, Map const & m)
+		{
+			write(path, m.begin(), m.end(), m.key_comp());
+		}
+
+	// Iterators
+		const_iterator			begin() const		{ return _file.begin(); }
+		const_iterator			end() const			{ return _file.end(); }
+		const_reverse_iterator	rbegin() const		{ return _file.rbegin(); }
+		const_reverse_iterator	rend() const		{ return _file.rend(); }
+
+	// Capacity
+		bool				empty() const			{ return _file.empty(); }
+		size_type			size() const			{ return _file.size(); }
+
+	// Element access
+		mapped_type const &	at(key_type const & key) const
+		{
+			const_iterator	it = find(key);
+
+			if (it == end())
+				throw std::out_of_range("mapped_map::at()::out_of_range");
+			return (*it).second;
+		}
+
+		void			swap(mapped_map & m)					{ _file.swap(m._file); }
+
+	// Observers
+		key_compare		key_comp() const						{ return _file.key_comp(); }
+
+	// Operations
+		const_iterator	find(key_type const & key) const		{ return _file.find(key); }
+		size_type		count(key_type const & key) const		{ return _file.count(key); }
+		const_iterator	lower_bound(key_type const & key) const	{ return _file.lower_bound(key); }
+		const_iterator	upper_bound(key_type const & key) const	{ return _file.upper_bound(key); }
+
+		pair<const_iterator,const_iterator>		equal_range(key_type const & key) const {
+			return _file.equal_range(key);
+		}
+
+	private:
+		mapped_map (mapped_map const &);
+		mapped_map &	operator = (mapped_map const &);
+};
+
+	template < class Key, class T, class Comp >
+	void		swap(mapped_map<Key, T, Comp> & lhs, mapped_map<Key, T, Comp> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
+
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef FT_MAPPED_SET_HPP
+# define FT_MAPPED_SET_HPP
+
+# include "mapped_tree.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+// Read-only ft::set served straight from a file written by mapped_set::write
+template	<	class Key,
+				class Compare = less<Key>
+			>
+class	mapped_set
+{
+	// Type definitions
+	public:
+		typedef Key											key_type;
+		typedef Key											value_type;
+		typedef Compare										key_compare;
+		typedef Compare										value_compare;
+
+	private:
+		typedef mapped::sorted_file <	key_type,
+										value_type,
+										identity<value_type>,
+										key_compare	>		file_type;
+
+	public:
+		typedef typename file_type::size_type				size_type;
+		typedef typename file_type::difference_type			difference_type;
+		typedef typename file_type::reference				reference;
+		typedef typename file_type::const_reference			const_reference;
+		typedef typename file_type::pointer					pointer;
+		typedef typename file_type::const_pointer			const_pointer;
+		typedef typename file_type::iterator				iterator;
+		typedef typename file_type::const_iterator			const_iterator;
+		typedef typename file_type::reverse_iterator		reverse_iterator;
+		typedef typename file_type::const_reverse_iterator	const_reverse_iterator;
+
+	// File
+	private:
+		file_type		_file;
+
+	// Constructors
+	public:
+		explicit mapped_set (key_compare const & comp = key_compare())
+			: _file(comp)									{ }
+
+		explicit mapped_set (char const * path, key_compare const & comp = key_compare())
+			: _file(comp)
+		{
+			_file.open(path);
+		}
+
+		~mapped_set ()										{ }
+
+	// File
+		void			open(char const * path)					{ _file.open(path); }
+		void			close()									{ _file.close(); }
+		bool			is_open() const							{ return _file.is_open(); }
+		void			advise(int advice) const				{ _file.advise(advice); }
+
+		template < class InputIterator >
+		static void		write(char const * path, InputIterator first, InputIterator last,
+							  key_compare const & comp = key_compare())
+		{
+			file_type::write(path, first, last, comp);
+		}
+
+		template < class Set >
+		static void		write(char const * path, Set const & s)
+		{
+			write(path, s.begin(), s.end(), s.key_comp());
+		}
+
+	// Iterators
+		const_iterator			begin() const		{ return _file.begin(); }
+		const_iterator			end() const			{ return _file.end(); }
+		const_reverse_iterator	rbegin() const		{ return _file.rbegin(); }
+		const_reverse_iterator	rend() const		{ return _file.rend(); }
+
+	// Capacity
+		bool				empty() const			{ return _file.empty(); }
+		size_type			size() const			{ return _file.size(); }
+
+		void			swap(mapped_set & s)					{ _file.swap(s._file); }
+
+	// Observers
+		key_compare		key_comp() const						{ return _file.key_comp(); }
+		value_compare	value_comp() const						{ return _file.key_comp(); }
+
+	// Operations
+		const_iterator	find(key_type const & key) const		{ return _file.find(key); }
+		size_type		count(key_type const & key) const		{ return _file.count(key); }
+		const_iterator	lower_bound(key_type const & key) const	{ return _file.lower_bound(key); }
+		const_iterator	upper_bound(key_type const & key) const	{ return _file.upper_bound(key); }
+
+		pair<const_iterator,const_iterator>		equal_range(key_type const & key) const {
+			return _file.equal_range(key);
+		}
+
+	private:
+		mapped_set (mapped_set const &);
+		mapped_set &	operator = (mapped_set const &);
+};
+
+	template < class Key, class Comp >
+	void		swap(mapped_set<Key, Comp> & lhs, mapped_set<Key, Comp> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
+
+
+#endif
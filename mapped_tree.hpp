@@ -0,0 +1,402 @@
+#ifndef FT_MAPPED_TREE_HPP
+# define FT_MAPPED_TREE_HPP
+
+# include <cstdio>
+# include <cstring>
+# include <stdexcept>
+
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+
+# include "iterator.hpp"
+# include "vector.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+namespace	mapped
+
+{
+
+// On-disk layout shared by ft::mapped_map and ft::mapped_set
+//
+//	[ header, 64 bytes ][ values, sorted by key ][ pad ][ index ]
+//
+// Values are stored contiguously in key order, the index holds the key of
+// every index_stride-th value so a lookup binary searches a small, cache
+// resident array first and then a single run of index_stride values.
+// Keys and values must be trivially copyable: the file is mapped and
+// read in place, nothing is deserialized.
+
+static const size_t		index_stride = 64;
+
+struct	header
+{
+	char				magic[8];
+	unsigned long long	size;
+	unsigned long long	value_size;
+	unsigned long long	key_size;
+	unsigned long long	stride;
+	unsigned long long	index_offset;
+	unsigned long long	index_size;
+	char				_pad[8];
+};
+
+inline char const *		magic()							{ return "ftmapd01"; }
+inline size_t			round_up(size_t n, size_t to)	{ return (n + to - 1) / to * to; }
+
+template <	typename Key, typename Value, typename KeyOfValue, typename Compare >
+class	sorted_file
+{
+	// Type definitions
+	public:
+		typedef Key											key_type;
+		typedef Value										value_type;
+		typedef Compare										key_compare;
+		typedef size_t										size_type;
+		typedef ptrdiff_t									difference_type;
+		typedef value_type const &							reference;
+		typedef value_type const &							const_reference;
+		typedef value_type const *							pointer;
+		typedef value_type const *							const_pointer;
+		typedef ft::iterator<const_pointer>					iterator;
+		typedef ft::iterator<const_pointer>					const_iterator;
+		typedef ft::reverse_iterator<const_iterator>		reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+	// Private members
+	private:
+		typedef char	_requires_trivially_copyable_key[is_trivially_copyable<Key>::value ? 1 : -1];
+		typedef char	_requires_trivially_copyable_value[is_trivially_copyable<Value>::value ? 1 : -1];
+
+		char *				_map;
+		size_type			_map_size;
+		const_pointer		_values;
+		key_type const *	_index;
+		size_type			_size;
+		size_type			_index_size;
+		key_compare			_comp;
+		KeyOfValue			_key_of;
+
+	// Constructors
+	public:
+		explicit sorted_file(key_compare const & comp = key_compare())
+			: _map(NULL), _map_size(0), _values(NULL), _index(NULL),
+			  _size(0), _index_size(0), _comp(comp)
+		{
+		}
+
+		~sorted_file()
+		{
+			close();
+		}
+
+	// Member functions
+		void			open(char const * path)
+		{
+			struct stat	st;
+			int			fd;
+			void *		p;
+
+			close();
+			fd = ::open(path, O_RDONLY);
+			if (fd < 0) {
+				throw std::runtime_error("mapped::open()::open_failed");
+			}
+			if (fstat(fd, &st) < 0 || static_cast<size_type>(st.st_size) < sizeof(header)) {
+				::close(fd);
+				throw std::runtime_error("mapped::open()::bad_file");
+			}
+			p = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+			::close(fd);
+			if (p == MAP_FAILED) {
+				throw std::runtime_error("mapped::open()::mmap_failed");
+			}
+			_map = static_cast<char *>(p);
+			_map_size = static_cast<size_type>(st.st_size);
+
+			header const *	h = reinterpret_cast<header const *>(_map);
+
+			if (!_valid(h, _map_size)) {
+				close();
+				throw std::runtime_error("mapped::open()::bad_file");
+			}
+			_values = reinterpret_cast<const_pointer>(_map + sizeof(header));
+			_index = reinterpret_cast<key_type const *>(_map + h->index_offset);
+			_size = h->size;
+			_index_size = h->index_size;
+		}
+
+		void			close()
+		{
+			if (_map) {
+				munmap(_map, _map_size);
+			}
+			_map = NULL;
+			_map_size = 0;
+			_values = NULL;
+			_index = NULL;
+			_size = 0;
+			_index_size = 0;
+		}
+
+		bool			is_open() const		{ return _map != NULL; }
+
+		// Hint for the lookup pattern: random for point queries,
+		// sequential for full scans, willneed to pre-fault the whole file
+		void			advise(int advice) const
+		{
+			if (_map) {
+				madvise(_map, _map_size, advice);
+			}
+		}
+
+		void			swap(sorted_file & other)
+		{
+			std::swap(_map, other._map);
+			std::swap(_map_size, other._map_size);
+			std::swap(_values, other._values);
+			std::swap(_index, other._index);
+			std::swap(_size, other._size);
+			std::swap(_index_size, other._index_size);
+			std::swap(_comp, other._comp);
+		}
+
+	// Iterators
+		const_iterator			begin() const		{ return const_iterator(_values); }
+		const_iterator			end() const			{ return const_iterator(_values + _size); }
+		const_reverse_iterator	rbegin() const		{ return const_reverse_iterator(end()); }
+		const_reverse_iterator	rend() const		{ return const_reverse_iterator(begin()); }
+
+	// Capacity
+		bool			empty() const		{ return _size == 0; }
+		size_type		size() const		{ return _size; }
+
+	// Observers
+		key_compare		key_comp() const	{ return _comp; }
+
+	// Operations
+		const_iterator	find(key_type const & key) const
+		{
+			const_pointer	p = _values + _lower_bound(key);
+
+			if (p == _values + _size || _comp(key, _key_of(*p))) {
+				return end();
+			}
+			return const_iterator(p);
+		}
+
+		size_type		count(key_type const & key) const
+		{
+			return find(key) == end() ? 0 : 1;
+		}
+
+		const_iterator	lower_bound(key_type const & key) const
+		{
+			return const_iterator(_values + _lower_bound(key));
+		}
+
+		const_iterator	upper_bound(key_type const & key) const
+		{
+			return const_iterator(_values + _upper_bound(key));
+		}
+
+		pair<const_iterator, const_iterator>	equal_range(key_type const & key) const
+		{
+			return pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+		}
+
+	// Writer
+	// Streams values, already sorted and unique by key, to a file the
+	// reader can map; only the sparse index is kept in memory
+		class	writer
+		{
+			std::FILE *				_file;
+			size_type				_size;
+			ft::vector<key_type>	_keys;
+			value_type				_last;
+			key_compare				_comp;
+			KeyOfValue				_key_of;
+
+			writer(writer const &);
+			writer &	operator = (writer const &);
+
+			public:
+				explicit writer(char const * path, key_compare const & comp = key_compare())
+					: _file(std::fopen(path, "wb")), _size(0), _comp(comp)
+				{
+					header	h;
+
+					if (!_file) {
+						throw std::runtime_error("mapped::writer()::open_failed");
+					}
+					std::memset(&h, 0, sizeof(h));
+					_write(&h, sizeof(h));
+				}
+
+				~writer()
+				{
+					if (_file) {
+						std::fclose(_file);
+					}
+				}
+
+				void	append(value_type const & value)
+				{
+					key_type const &	key = _key_of(value);
+
+					if (_size && !_comp(_key_of(_last), key)) {
+						throw std::invalid_argument("mapped::writer::append()::unsorted");
+					}
+					if (_size % index_stride == 0) {
+						_keys.push_back(key);
+					}
+					_write(&value, sizeof(value));
+					_last = value;
+					_size++;
+				}
+
+				// Writes the index and the header; the file is complete
+				// only once this returns
+				void	finish()
+				{
+					size_type	offset = sizeof(header) + _size * sizeof(value_type);
+					size_type	index_offset = round_up(offset, 64);
+					char		zero[64];
+					header		h;
+
+					std::memset(zero, 0, sizeof(zero));
+					_write(zero, index_offset - offset);
+					if (!_keys.empty()) {
+						_write(_keys.data(), _keys.size() * sizeof(key_type));
+					}
+
+					std::memset(&h, 0, sizeof(h));
+					std::memcpy(h.magic, magic(), sizeof(h.magic));
+					h.size = _size;
+					h.value_size = sizeof(value_type);
+					h.key_size = sizeof(key_type);
+					h.stride = index_stride;
+					h.index_offset = index_offset;
+					h.index_size = _keys.size();
+					if (std::fseek(_file, 0, SEEK_SET) != 0) {
+						throw std::runtime_error("mapped::writer::finish()::seek_failed");
+					}
+					_write(&h, sizeof(h));
+					if (std::fclose(_file) != 0) {
+						_file = NULL;
+						throw std::runtime_error("mapped::writer::finish()::write_failed");
+					}
+					_file = NULL;
+				}
+
+			private:
+				void	_write(void const * p, size_type bytes)
+				{
+					if (bytes && std::fwrite(p, bytes, 1, _file) != 1) {
+						throw std::runtime_error("mapped::writer()::write_failed");
+					}
+				}
+		};
+
+		template < class InputIterator >
+		static void		write(char const * path, InputIterator first, InputIterator last,
+							  key_compare const & comp = key_compare())
+		{
+			writer	w(path, comp);
+
+			for (; first != last; ++first) {
+				w.append(*first);
+			}
+			w.finish();
+		}
+
+	// Private member functions
+	private:
+		sorted_file(sorted_file const &);
+		sorted_file &	operator = (sorted_file const &);
+
+		// Every count is bounded by the room left in the mapping before it is
+		// multiplied, so a corrupt header can not wrap the sizes around
+		static bool		_valid(header const * h, size_type map_size)
+		{
+			size_type const	values_room = (map_size - sizeof(header)) / sizeof(value_type);
+
+			if (std::memcmp(h->magic, magic(), sizeof(h->magic)) != 0
+				|| h->value_size != sizeof(value_type) || h->key_size != sizeof(key_type)
+				|| h->stride != index_stride
+				|| h->size > values_room
+				|| h->index_offset > map_size
+				|| h->index_offset < sizeof(header) + h->size * sizeof(value_type)
+				|| h->index_offset % alignment_of<key_type>::value != 0
+				|| h->index_size > (map_size - h->index_offset) / sizeof(key_type)) {
+				return false;
+			}
+			return h->index_size == (h->size + index_stride - 1) / index_stride;
+		}
+
+		// The run [lo, hi) holding the answer is found in the index first:
+		// every value before the matching index entry's predecessor is
+		// already known to be on the wrong side of the key
+		size_type		_lower_bound(key_type const & key) const
+		{
+			size_type	lo = 0;
+			size_type	hi = _index_size;
+
+			while (lo < hi) {
+				size_type	mid = lo + (hi - lo) / 2;
+
+				if (_comp(_index[mid], key))
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			hi = std::min(lo * index_stride, _size);
+			lo = lo ? (lo - 1) * index_stride + 1 : 0;
+			while (lo < hi) {
+				size_type	mid = lo + (hi - lo) / 2;
+
+				if (_comp(_key_of(_values[mid]), key))
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return lo;
+		}
+
+		size_type		_upper_bound(key_type const & key) const
+		{
+			size_type	lo = 0;
+			size_type	hi = _index_size;
+
+			while (lo < hi) {
+				size_type	mid = lo + (hi - lo) / 2;
+
+				if (!_comp(key, _index[mid]))
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			hi = std::min(lo * index_stride, _size);
+			lo = lo ? (lo - 1) * index_stride + 1 : 0;
+			while (lo < hi) {
+				size_type	mid = lo + (hi - lo) / 2;
+
+				if (!_comp(key, _key_of(_values[mid])))
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return lo;
+		}
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,468 @@
+#ifndef FT_MEMORY_RESOURCE_HPP
+# define FT_MEMORY_RESOURCE_HPP
+
+# include <new>
+# include <cstddef>
+
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+size_t const	max_align = alignment_of<long double>::value;
+
+// Polymorphic source of raw memory: containers using a
+// polymorphic_allocator share one type whatever resource backs them
+class	memory_resource
+{
+	public:
+		virtual ~memory_resource()											{ }
+
+		void *			allocate(size_t bytes, size_t alignment = max_align) {
+			return do_allocate(bytes, alignment);
+		}
+		void			deallocate(void * p, size_t bytes, size_t alignment = max_align) {
+			do_deallocate(p, bytes, alignment);
+		}
+		bool			is_equal(memory_resource const & other) const {
+			return do_is_equal(other);
+		}
+
+	protected:
+		virtual void *	do_allocate(size_t bytes, size_t alignment) = 0;
+		virtual void	do_deallocate(void * p, size_t bytes, size_t alignment) = 0;
+		virtual bool	do_is_equal(memory_resource const & other) const = 0;
+};
+
+inline	bool	operator == (memory_resource const & lhs, memory_resource const & rhs) {
+	return &lhs == &rhs || lhs.is_equal(rhs);
+}
+inline	bool	operator != (memory_resource const & lhs, memory_resource const & rhs) {
+	return !(lhs == rhs);
+}
+
+class	new_delete_memory_resource : public memory_resource
+{
+	protected:
+		// operator new only guarantees max_align: stricter requests are
+		// over-allocated and aligned by hand, the block's own address kept
+		// in the word right before the one handed out
+		void *			do_allocate(size_t bytes, size_t alignment)
+		{
+			if (alignment <= max_align) {
+				return ::operator new(bytes);
+			}
+
+			char *	raw = static_cast<char *>(::operator new(bytes + alignment + sizeof(void *)));
+			size_t	p = reinterpret_cast<size_t>(raw + sizeof(void *));
+
+			p = (p + alignment - 1) & ~(alignment - 1);
+			reinterpret_cast<void **>(p)[-1] = raw;
+			return reinterpret_cast<void *>(p);
+		}
+
+		void			do_deallocate(void * p, size_t, size_t alignment)
+		{
+			if (alignment <= max_align) {
+				::operator delete(p);
+			}
+			else {
+				::operator delete(static_cast<void **>(p)[-1]);
+			}
+		}
+		bool			do_is_equal(memory_resource const & other) const {
+			return this == &other;
+		}
+};
+
+inline	memory_resource *	new_delete_resource()
+{
+	static new_delete_memory_resource	resource;
+
+	return &resource;
+}
+
+inline	memory_resource *&	_default_resource()
+{
+	static memory_resource *	resource = new_delete_resource();
+
+	return resource;
+}
+
+inline	memory_resource *	get_default_resource()	{ return _default_resource(); }
+
+inline	memory_resource *	set_default_resource(memory_resource * r)
+{
+	memory_resource *	old = _default_resource();
+
+	_default_resource() = r ? r : new_delete_resource();
+	return old;
+}
+
+inline	char *	align_up(char * p, size_t alignment)
+{
+	size_t const	mask = alignment - 1;
+
+	return reinterpret_cast<char *>((reinterpret_cast<size_t>(p) + mask) & ~mask);
+}
+
+// Arena: bump-allocates from geometrically growing chunks,
+// deallocate() is a no-op and release() frees everything at once
+class	monotonic_buffer_resource : public memory_resource
+{
+	struct	chunk
+	{
+		chunk *		next;
+		size_t		size;
+	};
+
+	private:
+		memory_resource *	_upstream;
+		char *				_initial;
+		size_t				_initial_size;
+		char *				_cur;
+		char *				_end;
+		size_t				_next_size;
+		chunk *				_chunks;
+
+		monotonic_buffer_resource(monotonic_buffer_resource const &);
+		monotonic_buffer_resource &	operator = (monotonic_buffer_resource const &);
+
+	public:
+		explicit monotonic_buffer_resource(memory_resource * upstream = get_default_resource())
+			: _upstream(upstream), _initial(NULL), _initial_size(0),
+			  _cur(NULL), _end(NULL), _next_size(1024), _chunks(NULL)		{ }
+
+		explicit monotonic_buffer_resource(size_t initial_size,
+										   memory_resource * upstream = get_default_resource())
+			: _upstream(upstream), _initial(NULL), _initial_size(0),
+			  _cur(NULL), _end(NULL), _next_size(initial_size ? initial_size : 1024), _chunks(NULL)	{ }
+
+		// Serves from the caller's buffer first, then from upstream
+		monotonic_buffer_resource(void * buffer, size_t size,
+								  memory_resource * upstream = get_default_resource())
+			: _upstream(upstream), _initial(static_cast<char *>(buffer)), _initial_size(size),
+			  _cur(_initial), _end(_initial + size), _next_size(size ? size * 2 : 1024), _chunks(NULL)	{ }
+
+		~monotonic_buffer_resource()
+		{
+			release();
+		}
+
+		// Returns every chunk to upstream; previously allocated memory becomes invalid
+		void				release()
+		{
+			while (_chunks) {
+				chunk *	next = _chunks->next;
+				_upstream->deallocate(_chunks, _chunks->size);
+				_chunks = next;
+			}
+			_cur = _initial;
+			_end = _initial + _initial_size;
+		}
+
+		memory_resource *	upstream_resource() const		{ return _upstream; }
+
+	protected:
+		void *				do_allocate(size_t bytes, size_t alignment)
+		{
+			char *	p = align_up(_cur, alignment);
+
+			if (!_cur || p + bytes > _end) {
+				size_t const	need = sizeof(chunk) + bytes + alignment;
+				size_t			size = _next_size;
+
+				while (size < need) {
+					size *= 2;
+				}
+
+				chunk *	c = static_cast<chunk *>(_upstream->allocate(size));
+
+				c->next = _chunks;
+				c->size = size;
+				_chunks = c;
+				_cur = reinterpret_cast<char *>(c + 1);
+				_end = reinterpret_cast<char *>(c) + size;
+				_next_size = size * 2;
+				p = align_up(_cur, alignment);
+			}
+			_cur = p + bytes;
+			return p;
+		}
+
+		void				do_deallocate(void *, size_t, size_t)		{ }
+
+		bool				do_is_equal(memory_resource const & other) const {
+			return this == &other;
+		}
+};
+
+// Pools of fixed-size blocks, one per power of two up to largest_block;
+// freed blocks go back to their pool, bigger requests go to upstream.
+// Not thread safe
+class	unsynchronized_pool_resource : public memory_resource
+{
+	struct	block	{ block * next; };
+
+	struct	chunk
+	{
+		chunk *		next;
+		size_t		size;
+	};
+
+	// Header in front of an oversized allocation, kept in a list for release()
+	struct	large
+	{
+		large *		prev;
+		large *		next;
+		size_t		size;
+		size_t		pad;
+	};
+
+	static const size_t	_min_block = 16;
+	static const size_t	_num_pools = 9;		// 16 .. 4096 bytes
+
+	struct	pool
+	{
+		block *		free;
+		size_t		blocks_per_chunk;
+	};
+
+	private:
+		memory_resource *	_upstream;
+		size_t				_largest_block;
+		pool				_pools[_num_pools];
+		chunk *				_chunks;
+		large *				_large;
+
+		unsynchronized_pool_resource(unsynchronized_pool_resource const &);
+		unsynchronized_pool_resource &	operator = (unsynchronized_pool_resource const &);
+
+	public:
+		explicit unsynchronized_pool_resource(memory_resource * upstream = get_default_resource(),
+											  size_t largest_block = 512)
+			: _upstream(upstream), _largest_block(largest_block), _chunks(NULL), _large(NULL)
+		{
+			size_t const	cap = _min_block << (_num_pools - 1);
+
+			if (_largest_block > cap) {
+				_largest_block = cap;
+			}
+			for (size_t i = 0; i < _num_pools; i++) {
+				_pools[i].free = NULL;
+				_pools[i].blocks_per_chunk = 16;
+			}
+		}
+
+		~unsynchronized_pool_resource()
+		{
+			release();
+		}
+
+		void				release()
+		{
+			while (_chunks) {
+				chunk *	next = _chunks->next;
+				_upstream->deallocate(_chunks, _chunks->size);
+				_chunks = next;
+			}
+			while (_large) {
+				large *	next = _large->next;
+				_upstream->deallocate(reinterpret_cast<char *>(_large + 1) - _large->pad, _large->size);
+				_large = next;
+			}
+			for (size_t i = 0; i < _num_pools; i++) {
+				_pools[i].free = NULL;
+				_pools[i].blocks_per_chunk = 16;
+			}
+		}
+
+		memory_resource *	upstream_resource() const		{ return _upstream; }
+
+	protected:
+		void *				do_allocate(size_t bytes, size_t alignment)
+		{
+			size_t const	size = bytes > alignment ? bytes : alignment;
+
+			if (size > _largest_block || alignment > max_align) {
+				return _allocate_large(bytes, alignment);
+			}
+
+			size_t const	index = _pool_index(size);
+			pool &			p = _pools[index];
+
+			if (!p.free) {
+				_refill(p, _min_block << index);
+			}
+
+			block *	b = p.free;
+			p.free = b->next;
+			return b;
+		}
+
+		void				do_deallocate(void * ptr, size_t bytes, size_t alignment)
+		{
+			size_t const	size = bytes > alignment ? bytes : alignment;
+
+			if (size > _largest_block || alignment > max_align) {
+				_deallocate_large(ptr);
+				return ;
+			}
+
+			pool &	p = _pools[_pool_index(size)];
+			block *	b = static_cast<block *>(ptr);
+
+			b->next = p.free;
+			p.free = b;
+		}
+
+		bool				do_is_equal(memory_resource const & other) const {
+			return this == &other;
+		}
+
+	private:
+		static size_t		_pool_index(size_t size)
+		{
+			size_t	index = 0;
+
+			while ((_min_block << index) < size) {
+				index++;
+			}
+			return index;
+		}
+
+		// Carves a new chunk into blocks; chunks double per pool up to 1024 blocks
+		void				_refill(pool & p, size_t block_size)
+		{
+			size_t const	header = (sizeof(chunk) + max_align - 1) / max_align * max_align;
+			size_t const	size = header + p.blocks_per_chunk * block_size;
+			chunk *			c = static_cast<chunk *>(_upstream->allocate(size));
+			char *			first = reinterpret_cast<char *>(c) + header;
+
+			c->next = _chunks;
+			c->size = size;
+			_chunks = c;
+			for (size_t i = p.blocks_per_chunk; i > 0; i--) {
+				block *	b = reinterpret_cast<block *>(first + (i - 1) * block_size);
+				b->next = p.free;
+				p.free = b;
+			}
+			if (p.blocks_per_chunk < 1024) {
+				p.blocks_per_chunk *= 2;
+			}
+		}
+
+		void *				_allocate_large(size_t bytes, size_t alignment)
+		{
+			// Aligned here rather than by the upstream, which may not
+			// honour alignments past max_align
+			size_t const	size = sizeof(large) + alignment + bytes;
+			char *			raw = static_cast<char *>(_upstream->allocate(size));
+			char *			ptr = align_up(raw + sizeof(large), alignment);
+			large *			l = reinterpret_cast<large *>(ptr) - 1;
+
+			l->prev = NULL;
+			l->next = _large;
+			l->size = size;
+			l->pad = ptr - raw;
+			if (_large) {
+				_large->prev = l;
+			}
+			_large = l;
+			return ptr;
+		}
+
+		void				_deallocate_large(void * ptr)
+		{
+			large *	l = static_cast<large *>(ptr) - 1;
+			char *	raw = static_cast<char *>(ptr) - l->pad;
+
+			if (l->prev) {
+				l->prev->next = l->next;
+			}
+			else {
+				_large = l->next;
+			}
+			if (l->next) {
+				l->next->prev = l->prev;
+			}
+			_upstream->deallocate(raw, l->size);
+		}
+};
+
+// std::allocator compatible allocator forwarding to a memory_resource;
+// it is stateful, containers keep the resource of the allocator they were built with
+template < class T >
+class	polymorphic_allocator
+{
+	// Type definitions
+	public:
+		typedef T				value_type;
+		typedef T *				pointer;
+		typedef T const *		const_pointer;
+		typedef T &				reference;
+		typedef T const &		const_reference;
+		typedef size_t			size_type;
+		typedef ptrdiff_t		difference_type;
+
+		template < class U >
+		struct	rebind		{ typedef polymorphic_allocator<U> other; };
+
+	private:
+		memory_resource *	_resource;
+
+	// Constructors
+	public:
+		polymorphic_allocator() : _resource(get_default_resource())					{ }
+		polymorphic_allocator(memory_resource * r) : _resource(r)					{ }
+		polymorphic_allocator(polymorphic_allocator const & other)
+			: _resource(other._resource)											{ }
+		template < class U >
+		polymorphic_allocator(polymorphic_allocator<U> const & other)
+			: _resource(other.resource())											{ }
+		~polymorphic_allocator()													{ }
+
+		polymorphic_allocator &	operator = (polymorphic_allocator const & other)
+		{
+			_resource = other._resource;
+			return *this;
+		}
+
+	// Member functions
+		memory_resource *	resource() const					{ return _resource; }
+
+		pointer			address(reference x) const			{ return &x; }
+		const_pointer	address(const_reference x) const	{ return &x; }
+		size_type		max_size() const					{ return size_type(-1) / sizeof(T); }
+
+		pointer			allocate(size_type n, void const * = 0)
+		{
+			if (n > max_size()) {
+				throw std::bad_alloc();
+			}
+			return static_cast<pointer>(_resource->allocate(n * sizeof(T), alignment_of<T>::value));
+		}
+
+		void			deallocate(pointer p, size_type n)
+		{
+			_resource->deallocate(p, n * sizeof(T), alignment_of<T>::value);
+		}
+
+		void			construct(pointer p, const_reference value)	{ new (static_cast<void *>(p)) T(value); }
+		void			destroy(pointer p)							{ p->~T(); }
+
+	// Non-member overloads
+		template < class U >
+		bool			operator == (polymorphic_allocator<U> const & rhs) const {
+			return *_resource == *rhs.resource();
+		}
+		template < class U >
+		bool			operator != (polymorphic_allocator<U> const & rhs) const {
+			return !(*this == rhs);
+		}
+};
+
+}
+
+#endif
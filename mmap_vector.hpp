@@ -0,0 +1,426 @@
+#ifndef FT_MMAP_VECTOR_HPP
+# define FT_MMAP_VECTOR_HPP
+
+# include <cstring>
+# include <algorithm>
+# include <stdexcept>
+
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+
+# include "iterator.hpp"
+# include "utils.hpp"
+# include "growth_policy.hpp"
+
+namespace	ft
+
+{
+
+// Vector of trivially copyable records stored in a memory-mapped file.
+// The file starts with a 64-byte header (magic, size, record size) followed
+// by the elements; opening an existing file maps it without reading or
+// copying anything. Capacity grows with ftruncate + remap, so pointers and
+// iterators are invalidated on growth exactly like ft::vector's.
+template < class T, class GrowthPolicy = growth_double >
+class	mmap_vector
+{
+	// Type definitions
+	public:
+		typedef T											value_type;
+		typedef GrowthPolicy								growth_policy;
+		typedef size_t										size_type;
+		typedef ptrdiff_t									difference_type;
+		typedef value_type &								reference;
+		typedef value_type const &							const_reference;
+		typedef value_type *								pointer;
+		typedef value_type const *							const_pointer;
+		typedef ft::iterator<pointer>						iterator;
+		typedef ft::iterator<const_pointer>					const_iterator;
+		typedef ft::reverse_iterator<iterator>				reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+		enum	access_pattern
+		{
+			normal,
+			sequential,
+			random,
+			willneed,
+			dontneed
+		};
+
+	// Private members
+	private:
+		// Records are copied byte-wise in and out of the file
+		typedef char	_requires_trivially_copyable[is_trivially_copyable<T>::value ? 1 : -1];
+
+		struct	header
+		{
+			char				magic[8];
+			unsigned long long	size;
+			unsigned long long	value_size;
+			char				_pad[40];
+		};
+
+		static const size_type	_header_size = sizeof(header);
+
+		int				_fd;
+		char *			_map;
+		size_type		_map_size;
+
+	// Constructors
+	public:
+		mmap_vector	() : _fd(-1), _map(NULL), _map_size(0)		{ }
+
+		// Opens path, creating an empty vector if the file does not exist
+		explicit mmap_vector	(char const * path) : _fd(-1), _map(NULL), _map_size(0)
+		{
+			open(path);
+		}
+
+		~mmap_vector()
+		{
+			close();
+		}
+
+	// Member functions
+		// On failure the vector is left closed
+		void			open(char const * path)
+		{
+			close();
+			_fd = ::open(path, O_RDWR | O_CREAT, 0644);
+			if (_fd < 0) {
+				throw std::runtime_error("mmap_vector::open()::open_failed");
+			}
+			try {
+				_open_file();
+			}
+			catch (...) {
+				close();
+				throw;
+			}
+		}
+
+		// Unmaps and closes the file; the elements stay on disk
+		void			close()
+		{
+			if (_map) {
+				munmap(_map, _map_size);
+			}
+			if (_fd >= 0) {
+				::close(_fd);
+			}
+			_fd = -1;
+			_map = NULL;
+			_map_size = 0;
+		}
+
+		bool			is_open() const		{ return _map != NULL; }
+
+		// Flushes dirty pages to the file, blocking unless async is set
+		void			sync(bool async = false)
+		{
+			if (_map && msync(_map, _map_size, async ? MS_ASYNC : MS_SYNC) < 0) {
+				throw std::runtime_error("mmap_vector::sync()::msync_failed");
+			}
+		}
+
+		// Access pattern hint for the whole mapping
+		void			advise(access_pattern pattern)
+		{
+			if (!_map)
+				return ;
+
+			int		advice = MADV_NORMAL;
+
+			switch (pattern) {
+				case sequential:	advice = MADV_SEQUENTIAL;	break;
+				case random:		advice = MADV_RANDOM;		break;
+				case willneed:		advice = MADV_WILLNEED;		break;
+				case dontneed:		advice = MADV_DONTNEED;		break;
+				default:			break;
+			}
+			madvise(_map, _map_size, advice);
+		}
+
+	// Capacity
+		size_type		size() const		{ return _map ? static_cast<size_type>(_header()->size) : 0; }
+		size_type		capacity() const	{ return _map ? (_map_size - _header_size) / sizeof(value_type) : 0; }
+		size_type		max_size() const	{ return (size_type(-1) / 2 - _header_size) / sizeof(value_type); }
+		bool			empty() const		{ return size() == 0; }
+
+		void			reserve(size_type n)
+		{
+			if (n > max_size())
+				throw std::length_error("mmap_vector::reserve()::length_error");
+			if (n > capacity()) {
+				_remap(_file_size(n));
+			}
+		}
+
+		// Truncates the file to the pages actually holding elements
+		void			shrink_to_fit()
+		{
+			if (_map && _file_size(size()) < _map_size) {
+				_remap(_file_size(size()));
+			}
+		}
+
+		void			resize(size_type n, value_type const & value = value_type())
+		{
+			if (n > capacity()) {
+				reserve(_recommend(n));
+			}
+			std::fill(_start() + std::min(n, size()), _start() + n, value);
+			_set_size(n);
+		}
+
+	// Modifiers
+		template < class InputIterator >
+		void			assign(InputIterator first, InputIterator last,
+						typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			clear();
+			while (first != last) {
+				push_back(*first++);
+			}
+		}
+
+		void			assign(size_type n, value_type const & value)
+		{
+			clear();
+			resize(n, value);
+		}
+
+		void			push_back(value_type const & value)
+		{
+			if (size() == capacity()) {
+				value_type	tmp(value);
+
+				reserve(_recommend(size() + 1));
+				_start()[size()] = tmp;
+			}
+			else {
+				_start()[size()] = value;
+			}
+			_set_size(size() + 1);
+		}
+
+		void			pop_back()		{ _set_size(size() - 1); }
+
+		iterator		insert(iterator pos, value_type const & value)
+		{
+			size_type	index = static_cast<size_type>(pos - begin());
+
+			insert(pos, 1, value);
+			return begin() + index;
+		}
+
+		void			insert(iterator pos, size_type count, value_type const & value)
+		{
+			size_type	index = static_cast<size_type>(pos - begin());
+			value_type	tmp(value);
+
+			if (count == 0)
+				return ;
+			if (size() + count > capacity()) {
+				reserve(_recommend(size() + count));
+			}
+			std::memmove(_start() + index + count, _start() + index,
+						 (size() - index) * sizeof(value_type));
+			std::fill(_start() + index, _start() + index + count, tmp);
+			_set_size(size() + count);
+		}
+
+		iterator		erase(iterator pos)
+		{
+			return erase(pos, pos + 1);
+		}
+
+		iterator		erase(iterator first, iterator last)
+		{
+			pointer		end = _start() + size();
+
+			std::memmove(first.base(), last.base(), (end - last.base()) * sizeof(value_type));
+			_set_size(size() - (last - first));
+			return first;
+		}
+
+		void			swap(mmap_vector & other)
+		{
+			std::swap(_fd, other._fd);
+			std::swap(_map, other._map);
+			std::swap(_map_size, other._map_size);
+		}
+
+		void			clear()			{ if (_map) _set_size(0); }
+
+	// Element access
+		reference		front()							{ return *_start(); }
+		const_reference	front() const					{ return *_start(); }
+		reference		back()							{ return _start()[size() - 1]; }
+		const_reference	back() const					{ return _start()[size() - 1]; }
+		reference		operator [] (size_type n)		{ return _start()[n]; }
+		const_reference	operator [] (size_type n) const	{ return _start()[n]; }
+
+		reference		at (size_type n)
+		{
+			if (n >= size())
+				throw std::out_of_range("mmap_vector::at()::out_of_range");
+			return	_start()[n];
+		}
+
+		const_reference	at (size_type n) const
+		{
+			if (n >= size())
+				throw std::out_of_range("mmap_vector::at()::out_of_range");
+			return	_start()[n];
+		}
+
+		pointer			data()							{ return _start(); }
+		const_pointer	data() const					{ return _start(); }
+
+	// Iterators
+		iterator				begin()			{ return iterator(_start()); }
+		const_iterator			begin() const	{ return const_iterator(_start()); }
+		iterator				end()			{ return iterator(_start() + size()); }
+		const_iterator			end() const		{ return const_iterator(_start() + size()); }
+		reverse_iterator		rbegin()		{ return reverse_iterator(end()); }
+		const_reverse_iterator	rbegin() const	{ return const_reverse_iterator(end()); }
+		reverse_iterator		rend()			{ return reverse_iterator(begin()); }
+		const_reverse_iterator	rend() const	{ return const_reverse_iterator(begin()); }
+
+	// Private member functions
+	private:
+		mmap_vector	(mmap_vector const &);
+		mmap_vector &	operator = (mmap_vector const &);
+
+		static char const *	_magic()			{ return "ftmmvec1"; }
+
+		header *		_header()				{ return reinterpret_cast<header *>(_map); }
+		header const *	_header() const			{ return reinterpret_cast<header const *>(_map); }
+		pointer			_start()				{ return _map ? reinterpret_cast<pointer>(_map + _header_size) : NULL; }
+		const_pointer	_start() const			{ return _map ? reinterpret_cast<const_pointer>(_map + _header_size) : NULL; }
+
+		void			_set_size(size_type n)	{ _header()->size = n; }
+
+		size_type		_recommend(size_type new_size) const
+		{
+			return growth_policy::recommend(capacity(), new_size, max_size(), sizeof(value_type));
+		}
+
+		// Header plus n elements, rounded up to whole pages
+		static size_type	_file_size(size_type n)
+		{
+			size_type const	page = static_cast<size_type>(sysconf(_SC_PAGESIZE));
+
+			return (_header_size + n * sizeof(value_type) + page - 1) / page * page;
+		}
+
+		// Maps the file opened on _fd, initializing it if it is empty;
+		// open() closes the vector if this throws
+		void			_open_file()
+		{
+			struct stat	st;
+
+			if (fstat(_fd, &st) < 0) {
+				throw std::runtime_error("mmap_vector::open()::stat_failed");
+			}
+			if (st.st_size == 0) {
+				_resize_file(_file_size(0));
+				_map_size = _file_size(0);
+				_map_file();
+				std::memcpy(_header()->magic, _magic(), sizeof(_header()->magic));
+				_header()->size = 0;
+				_header()->value_size = sizeof(value_type);
+				return ;
+			}
+			if (static_cast<size_type>(st.st_size) < _header_size) {
+				throw std::runtime_error("mmap_vector::open()::bad_file");
+			}
+			_map_size = static_cast<size_type>(st.st_size);
+			_map_file();
+			if (std::memcmp(_header()->magic, _magic(), sizeof(_header()->magic)) != 0
+				|| _header()->value_size != sizeof(value_type)
+				|| _header()->size > capacity()) {
+				throw std::runtime_error("mmap_vector::open()::bad_file");
+			}
+		}
+
+		void			_resize_file(size_type bytes)
+		{
+			if (ftruncate(_fd, static_cast<off_t>(bytes)) < 0) {
+				throw std::runtime_error("mmap_vector::reserve()::ftruncate_failed");
+			}
+		}
+
+		void			_map_file()
+		{
+			void *	p = mmap(NULL, _map_size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+
+			if (p == MAP_FAILED) {
+				throw std::runtime_error("mmap_vector::open()::mmap_failed");
+			}
+			_map = static_cast<char *>(p);
+		}
+
+		// Resizes the file and moves the mapping along with it; growing the
+		// file first keeps every mapped page backed. _map and _map_size only
+		// change once the new mapping exists: on failure the vector stays
+		// open and unchanged, and the file gets its old size back
+		void			_remap(size_type bytes)
+		{
+			size_type const	old_size = _map_size;
+
+			if (bytes > old_size) {
+				_resize_file(bytes);
+			}
+# ifdef MREMAP_MAYMOVE
+			void *	p = mremap(_map, old_size, bytes, MREMAP_MAYMOVE);
+# else
+			void *	p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+# endif
+			if (p == MAP_FAILED) {
+				if (bytes > old_size) {
+					// Best effort: the remap failure is the error reported,
+					// a file left longer than the mapping is still valid.
+					// The result goes through a variable because glibc's
+					// warn_unused_result is not silenced by a plain cast
+					int const	ignored = ftruncate(_fd, static_cast<off_t>(old_size));
+
+					(void)ignored;
+				}
+				throw std::runtime_error("mmap_vector::reserve()::mremap_failed");
+			}
+# ifndef MREMAP_MAYMOVE
+			munmap(_map, old_size);
+# endif
+			_map = static_cast<char *>(p);
+			_map_size = bytes;
+			if (bytes < old_size) {
+				_resize_file(bytes);
+			}
+		}
+
+	// Non-member overloads
+	public:
+		friend	bool	operator == (mmap_vector const & lhs, mmap_vector const & rhs) {
+			return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+		}
+		friend	bool	operator != (mmap_vector const & lhs, mmap_vector const & rhs) {
+			return !(lhs == rhs);
+		}
+
+};
+
+	template < class T, class Growth >
+	void	swap(mmap_vector<T, Growth> & lhs, mmap_vector<T, Growth> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
+
+
+#endif
@@ -0,0 +1,546 @@
+#ifndef FT_MULTIMAP_HPP
+# define FT_MULTIMAP_HPP
+
+# include <memory>
+
+# include "RBtree.hpp"
+# include "map.hpp"
+# include "vector.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+template	<	class Key,
+				class T,
+				class Compare = less<Key>,
+				class Allocator = std::allocator< pair<Key const, T> >
+			>
+class	multimap
+{
+	// Type definitions
+	public:
+		typedef Key											key_type;
+		typedef T											mapped_type;
+		typedef pair<key_type const, mapped_type>			value_type;
+		typedef Compare										key_compare;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::reference			reference;
+		typedef typename allocator_type::const_reference	const_reference;
+		typedef typename allocator_type::pointer			pointer;
+		typedef typename allocator_type::const_pointer		const_pointer;
+		typedef typename allocator_type::size_type			size_type;
+		typedef typename allocator_type::difference_type	difference_type;
+
+		typedef ft::rb::tree_iterator<value_type>			iterator;
+		typedef ft::rb::const_tree_iterator<value_type>		const_iterator;
+		typedef ft::reverse_iterator<iterator>				reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+		class	value_compare : public binary_function<value_type, value_type, bool>
+		{
+			friend class multimap;
+			protected:
+				key_compare	_comp;
+				value_compare(key_compare c) : _comp(c)	{ }
+
+			public:
+				bool	operator () (value_type const & lhs, value_type const & rhs) const {
+					return _comp(lhs.first, rhs.first);
+				}
+		};
+
+	// Tree
+	private:
+		typedef rb::RedBlackTree <	key_type,
+									value_type,
+									select1st<value_type>,
+									key_compare,
+									Allocator	>				tree_type;
+
+		tree_type		_tree;
+
+	// Constructors
+	public:
+		explicit multimap (key_compare const & comp = key_compare(),
+						   allocator_type const & alloc= allocator_type())
+			: _tree(comp, alloc)							{ }
+
+		template < class InputIterator >
+		multimap (InputIterator first, InputIterator last,
+				  key_compare const & comp = key_compare(),
+				  allocator_type const & alloc = allocator_type(),
+				  typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+			: _tree(comp, alloc)
+		{
+			_tree.insert_equal(first, last);
+		}
+
+		multimap (multimap const & other)	: _tree(other._tree)	{ }
+
+		~multimap ()												{ }
+
+		multimap &	operator = (multimap const & rhs)
+		{
+			_tree = rhs._tree;
+			return *this;
+		}
+
+	// Iterators
+		iterator				begin()				{ return _tree.begin(); }
+		const_iterator			begin() const		{ return _tree.begin(); }
+		iterator				end()				{ return _tree.end(); }
+		const_iterator			end() const			{ return _tree.end(); }
+
+		reverse_iterator		rbegin()			{ return _tree.rbegin(); }
+		const_reverse_iterator	rbegin() const		{ return _tree.rbegin(); }
+		reverse_iterator		rend()				{ return _tree.rend(); }
+		const_reverse_iterator	rend() const		{ return _tree.rend(); }
+
+	// Capacity
+		bool				empty() const			{ return _tree.empty(); }
+		size_type			size() const			{ return _tree.size(); }
+		size_type			max_size() const		{ return _tree.max_size(); }
+
+	// Modifiers
+		iterator		insert(value_type const & value)
+		{
+			return _tree.insert_equal(value);
+		}
+
+		iterator		insert(iterator pos, value_type const & value)
+		{
+			return _tree.insert_equal(pos, value);
+		}
+
+		template < class InputIterator >
+		void			insert(InputIterator first, InputIterator last,
+								   typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			return _tree.insert_equal(first, last);
+		}
+
+		void			erase(iterator pos)						{ return _tree.erase(pos); }
+		size_type		erase(key_type const & key)				{ return _tree.erase(key); }
+		void			erase(iterator first, iterator last)	{ return _tree.erase(first, last); }
+
+		void			erase_below(key_type const & key)		{ _tree.erase_below(key); }
+		void			erase_above(key_type const & key)		{ _tree.erase_above(key); }
+		void			clear()									{ _tree.clear(); }
+
+		void			swap(multimap & m)						{ _tree.swap(m._tree); }
+
+	// Observers
+		allocator_type	get_allocator() const					{ return _tree.get_allocator(); }
+		key_compare		key_comp() const						{ return _tree.key_comp(); }
+		value_compare	value_comp() const						{ return value_compare(_tree.key_comp()); }
+
+	// Operations
+		iterator		find(key_type const & key)				{ return _tree.find(key); }
+		const_iterator	find(key_type const & key) const		{ return _tree.find(key); }
+
+		size_type		count(key_type const & key) const		{ return _tree.count(key); }
+
+		iterator		lower_bound(key_type const & key)		{ return _tree.lower_bound(key); }
+		const_iterator	lower_bound(key_type const & key) const	{ return _tree.lower_bound(key); }
+
+		iterator		upper_bound(key_type const & key)		{ return _tree.upper_bound(key); }
+		const_iterator	upper_bound(key_type const & key) const	{ return _tree.upper_bound(key); }
+
+		pair<iterator,iterator>					equal_range(key_type const & key) {
+			return _tree.equal_range(key);
+		}
+		pair<const_iterator,const_iterator>		equal_range(key_type const & key) const {
+			return _tree.equal_range(key);
+		}
+
+	// Non-member overloads
+	public:
+		friend	bool	operator == (multimap const & lhs, multimap const & rhs) {
+			return lhs._tree == rhs._tree;
+		}
+		friend	bool	operator != (multimap const & lhs, multimap const & rhs) {
+			return lhs._tree != rhs._tree;
+		}
+		friend	bool	operator < (multimap const & lhs, multimap const & rhs) {
+			return lhs._tree < rhs._tree;
+		}
+		friend	bool	operator <= (multimap const & lhs, multimap const & rhs) {
+			return lhs._tree <= rhs._tree;
+		}
+		friend	bool	operator > (multimap const & lhs, multimap const & rhs) {
+			return lhs._tree > rhs._tree;
+		}
+		friend	bool	operator >= (multimap const & lhs, multimap const & rhs) {
+			return lhs._tree >= rhs._tree;
+		}
+};
+
+	template < class Key, class T, class Comp, class Alloc >
+	void		swap(multimap<Key, T, Comp, Alloc> & lhs, multimap<Key, T, Comp, Alloc> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+// Walks the values of a grouped_multimap: the group (one tree node per
+// distinct key) and the position inside its run of values
+template < class GroupIterator, class Value >
+class	grouped_iterator
+{
+	public:
+		typedef bidirectional_iterator_tag	iterator_category;
+		typedef Value						value_type;
+		typedef Value &						reference;
+		typedef Value *						pointer;
+		typedef ptrdiff_t					difference_type;
+
+	private:
+		GroupIterator	_group;
+		size_t			_index;
+
+	public:
+		grouped_iterator()											: _group(), _index(0)	{ }
+		grouped_iterator(GroupIterator group, size_t index)			: _group(group), _index(index)	{ }
+
+		template < class G, class V >
+		grouped_iterator(grouped_iterator<G, V> const & other)
+			: _group(other.group()), _index(other.index())									{ }
+
+		GroupIterator	group() const		{ return _group; }
+		size_t			index() const		{ return _index; }
+
+		reference		operator * () const		{ return (*_group).second[_index]; }
+		pointer			operator -> () const	{ return &(operator*()); }
+
+		grouped_iterator &	operator ++ ()
+		{
+			if (++_index == (*_group).second.size()) {
+				++_group;
+				_index = 0;
+			}
+			return *this;
+		}
+
+		grouped_iterator	operator ++ (int)
+		{
+			grouped_iterator	tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		grouped_iterator &	operator -- ()
+		{
+			if (_index == 0) {
+				--_group;
+				_index = (*_group).second.size();
+			}
+			--_index;
+			return *this;
+		}
+
+		grouped_iterator	operator -- (int)
+		{
+			grouped_iterator	tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		friend	bool	operator == (grouped_iterator const & lhs, grouped_iterator const & rhs) {
+			return lhs._group == rhs._group && lhs._index == rhs._index;
+		}
+		friend	bool	operator != (grouped_iterator const & lhs, grouped_iterator const & rhs) {
+			return !(lhs == rhs);
+		}
+};
+
+// Multimap storing each distinct key once in the tree, with all of its
+// values in one contiguous run: heavy duplicates do not add tree nodes or
+// height, and count/equal_range cost O(log n) whatever the run length.
+// Values keep their key next to them so iterators yield plain value_type
+// references. A run is an ft::vector: inserting into it may reallocate it,
+// which invalidates iterators and references into that run, and erasing a
+// single value moves the rest of the run; other runs are never touched.
+template	<	class Key,
+				class T,
+				class Compare = less<Key>,
+				class Allocator = std::allocator< pair<Key const, T> >
+			>
+class	grouped_multimap
+{
+	// Type definitions
+	public:
+		typedef Key											key_type;
+		typedef T											mapped_type;
+		typedef pair<key_type const, mapped_type>			value_type;
+		typedef Compare										key_compare;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::reference			reference;
+		typedef typename allocator_type::const_reference	const_reference;
+		typedef typename allocator_type::pointer			pointer;
+		typedef typename allocator_type::const_pointer		const_pointer;
+		typedef typename allocator_type::size_type			size_type;
+		typedef typename allocator_type::difference_type	difference_type;
+
+	private:
+		typedef ft::vector<value_type, Allocator>								run_type;
+		typedef pair<key_type const, run_type>									group_type;
+		typedef typename Allocator::template rebind<group_type>::other			group_allocator;
+		typedef ft::map<key_type, run_type, key_compare, group_allocator>		group_map;
+
+	public:
+		typedef grouped_iterator<typename group_map::iterator, value_type>				iterator;
+		typedef grouped_iterator<typename group_map::const_iterator, value_type const>	const_iterator;
+		typedef ft::reverse_iterator<iterator>											reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>									const_reverse_iterator;
+
+	// Private members
+	private:
+		group_map		_groups;
+		size_type		_size;
+		allocator_type	_alloc;
+
+	// Constructors
+	public:
+		explicit grouped_multimap (key_compare const & comp = key_compare(),
+								   allocator_type const & alloc = allocator_type())
+			: _groups(comp, group_allocator(alloc)), _size(0), _alloc(alloc)		{ }
+
+		template < class InputIterator >
+		grouped_multimap (InputIterator first, InputIterator last,
+						  key_compare const & comp = key_compare(),
+						  allocator_type const & alloc = allocator_type(),
+						  typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+			: _groups(comp, group_allocator(alloc)), _size(0), _alloc(alloc)
+		{
+			insert(first, last);
+		}
+
+		grouped_multimap (grouped_multimap const & other)
+			: _groups(other._groups), _size(other._size), _alloc(other._alloc)		{ }
+
+		~grouped_multimap ()														{ }
+
+		grouped_multimap &	operator = (grouped_multimap const & rhs)
+		{
+			_groups = rhs._groups;
+			_size = rhs._size;
+			return *this;
+		}
+
+	// Iterators
+		iterator				begin()				{ return iterator(_groups.begin(), 0); }
+		const_iterator			begin() const		{ return const_iterator(_groups.begin(), 0); }
+		iterator				end()				{ return iterator(_groups.end(), 0); }
+		const_iterator			end() const			{ return const_iterator(_groups.end(), 0); }
+
+		reverse_iterator		rbegin()			{ return reverse_iterator(end()); }
+		const_reverse_iterator	rbegin() const		{ return const_reverse_iterator(end()); }
+		reverse_iterator		rend()				{ return reverse_iterator(begin()); }
+		const_reverse_iterator	rend() const		{ return const_reverse_iterator(begin()); }
+
+	// Capacity
+		bool				empty() const			{ return _size == 0; }
+		size_type			size() const			{ return _size; }
+		size_type			max_size() const		{ return _alloc.max_size(); }
+		size_type			groups() const			{ return _groups.size(); }
+
+	// Modifiers
+		iterator		insert(value_type const & value)
+		{
+			typename group_map::iterator	g = _group_for(value.first);
+
+			try {
+				return _append(g, value);
+			}
+			catch (...) {
+				if ((*g).second.empty()) {
+					_groups.erase(g);
+				}
+				throw;
+			}
+		}
+
+		// A hint into the value's own run, or just past it as upper_bound()
+		// returns, skips the tree search; the value still goes last in its
+		// run, as without a hint
+		iterator		insert(iterator pos, value_type const & value)
+		{
+			typename group_map::iterator	g = pos.group();
+
+			if (g != _groups.end() && _same_key((*g).first, value.first)) {
+				return _append(g, value);
+			}
+			if (pos.index() == 0 && g != _groups.begin() && _same_key((*--g).first, value.first)) {
+				return _append(g, value);
+			}
+			return insert(value);
+		}
+
+		template < class InputIterator >
+		void			insert(InputIterator first, InputIterator last,
+							   typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			while (first != last) {
+				insert(*first++);
+			}
+		}
+
+		void			erase(iterator pos)
+		{
+			_erase_in_run(pos.group(), pos.index(), pos.index() + 1);
+		}
+
+		size_type		erase(key_type const & key)
+		{
+			typename group_map::iterator	g = _groups.find(key);
+
+			if (g == _groups.end()) {
+				return 0;
+			}
+
+			size_type const	count = (*g).second.size();
+
+			_groups.erase(g);
+			_size -= count;
+			return count;
+		}
+
+		void			erase(iterator first, iterator last)
+		{
+			while (first != last) {
+				typename group_map::iterator	g = first.group();
+				size_type const					to = last.group() == g ? last.index() : (*g).second.size();
+
+				if (to == (*g).second.size()) {
+					first = iterator(_erase_in_run(g, first.index(), to), 0);
+				}
+				else {
+					_erase_in_run(g, first.index(), to);
+					return ;
+				}
+			}
+		}
+
+		void			clear()
+		{
+			_groups.clear();
+			_size = 0;
+		}
+
+		void			swap(grouped_multimap & other)
+		{
+			_groups.swap(other._groups);
+			std::swap(_size, other._size);
+			std::swap(_alloc, other._alloc);
+		}
+
+	// Observers
+		allocator_type	get_allocator() const					{ return _alloc; }
+		key_compare		key_comp() const						{ return _groups.key_comp(); }
+
+	// Operations
+		iterator		find(key_type const & key)				{ return iterator(_groups.find(key), 0); }
+		const_iterator	find(key_type const & key) const		{ return const_iterator(_groups.find(key), 0); }
+
+		size_type		count(key_type const & key) const
+		{
+			typename group_map::const_iterator	g = _groups.find(key);
+
+			return g == _groups.end() ? 0 : (*g).second.size();
+		}
+
+		iterator		lower_bound(key_type const & key)		{ return iterator(_groups.lower_bound(key), 0); }
+		const_iterator	lower_bound(key_type const & key) const	{ return const_iterator(_groups.lower_bound(key), 0); }
+
+		iterator		upper_bound(key_type const & key)		{ return iterator(_groups.upper_bound(key), 0); }
+		const_iterator	upper_bound(key_type const & key) const	{ return const_iterator(_groups.upper_bound(key), 0); }
+
+		pair<iterator,iterator>					equal_range(key_type const & key) {
+			return pair<iterator,iterator>(lower_bound(key), upper_bound(key));
+		}
+		pair<const_iterator,const_iterator>		equal_range(key_type const & key) const {
+			return pair<const_iterator,const_iterator>(lower_bound(key), upper_bound(key));
+		}
+
+	// Private member functions
+	private:
+		typename group_map::iterator	_group_for(key_type const & key)
+		{
+			typename group_map::iterator	g = _groups.lower_bound(key);
+
+			if (g == _groups.end() || key_comp()(key, (*g).first)) {
+				g = _groups.insert(g, group_type(key, run_type(_alloc)));
+			}
+			return g;
+		}
+
+		bool			_same_key(key_type const & lhs, key_type const & rhs) const
+		{
+			return !key_comp()(lhs, rhs) && !key_comp()(rhs, lhs);
+		}
+
+		iterator		_append(typename group_map::iterator g, value_type const & value)
+		{
+			(*g).second.push_back(value);
+			_size++;
+			return iterator(g, (*g).second.size() - 1);
+		}
+
+		// Removes run[from, to) and the group once it is empty; returns
+		// the group following the run's remaining values
+		typename group_map::iterator	_erase_in_run(typename group_map::iterator g,
+													  size_type from, size_type to)
+		{
+			run_type &	run = (*g).second;
+
+			_size -= to - from;
+			if (from == 0 && to == run.size()) {
+				_groups.erase(g++);
+				return g;
+			}
+
+			run_type	rest(_alloc);
+
+			rest.reserve(run.size() - (to - from));
+			for (size_type i = 0; i < run.size(); i++) {
+				if (i < from || i >= to) {
+					rest.push_back(run[i]);
+				}
+			}
+			run.swap(rest);
+			return ++g;
+		}
+
+	// Non-member overloads
+	public:
+		friend	bool	operator == (grouped_multimap const & lhs, grouped_multimap const & rhs) {
+			return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+		}
+		friend	bool	operator != (grouped_multimap const & lhs, grouped_multimap const & rhs) {
+			return !(lhs == rhs);
+		}
+		friend	bool	operator < (grouped_multimap const & lhs, grouped_multimap const & rhs) {
+			return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+		friend	bool	operator <= (grouped_multimap const & lhs, grouped_multimap const & rhs) {
+			return !(rhs < lhs);
+		}
+		friend	bool	operator > (grouped_multimap const & lhs, grouped_multimap const & rhs) {
+			return rhs < lhs;
+		}
+		friend	bool	operator >= (grouped_multimap const & lhs, grouped_multimap const & rhs) {
+			return !(lhs < rhs);
+		}
+};
+
+	template < class Key, class T, class Comp, class Alloc >
+	void		swap(grouped_multimap<Key, T, Comp, Alloc> & lhs, grouped_multimap<Key, T, Comp, Alloc> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
+
+
+#endif
@@ -0,0 +1,432 @@
+#ifndef FT_MULTISET_HPP
+# define FT_MULTISET_HPP
+
+# include <memory>
+
+# include "RBtree.hpp"
+# include "map.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+template	<	class Key,
+				class Compare = less<Key>,
+				class Allocator = std::allocator<Key>
+			>
+class	multiset
+{
+	// Type definitions
+	public:
+		typedef Key											key_type;
+		typedef Key											value_type;
+		typedef Compare										key_compare;
+		typedef Compare										value_compare;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::reference			reference;
+		typedef typename allocator_type::const_reference	const_reference;
+		typedef typename allocator_type::pointer			pointer;
+		typedef typename allocator_type::const_pointer		const_pointer;
+		typedef typename allocator_type::size_type			size_type;
+		typedef typename allocator_type::difference_type	difference_type;
+
+	private:
+		typedef rb::RedBlackTree <	key_type,
+									value_type,
+									identity<value_type>,
+									key_compare,
+									Allocator	>			tree_type;
+
+	public:
+		typedef ft::rb::const_tree_iterator<value_type>		iterator;
+		typedef ft::rb::const_tree_iterator<value_type>		const_iterator;
+		typedef ft::reverse_iterator<iterator>				reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+		typedef typename tree_type::iterator				tree_iter;
+
+	// Tree
+	private:
+		tree_type		_tree;
+
+	// Constructors
+	public:
+		explicit multiset (key_compare const & comp = key_compare(),
+						   allocator_type const & alloc= allocator_type())
+			: _tree(comp, alloc)							{ }
+
+		template < class InputIterator >
+		multiset (InputIterator first, InputIterator last,
+				  key_compare const & comp = key_compare(),
+				  allocator_type const & alloc = allocator_type(),
+				  typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+			: _tree(comp, alloc)
+		{
+			_tree.insert_equal(first, last);
+		}
+
+		multiset (multiset const & other)	: _tree(other._tree)	{ }
+
+		~multiset ()												{ }
+
+		multiset &	operator = (multiset const & rhs)
+		{
+			_tree = rhs._tree;
+			return *this;
+		}
+
+	// Iterators
+		iterator			begin() const		{ return _tree.begin(); }
+		iterator			end() const			{ return _tree.end(); }
+		reverse_iterator	rbegin() const		{ return _tree.rbegin(); }
+		reverse_iterator	rend() const		{ return _tree.rend(); }
+
+	// Capacity
+		bool				empty() const		{ return _tree.empty(); }
+		size_type			size() const		{ return _tree.size(); }
+		size_type			max_size() const	{ return _tree.max_size(); }
+
+	// Modifiers
+		iterator		insert(value_type const & value)
+		{
+			return _tree.insert_equal(value);
+		}
+
+		iterator		insert(iterator pos, value_type const & value)
+		{
+			return _tree.insert_equal((tree_iter &)pos, value);
+		}
+
+		template < class InputIterator >
+		void			insert(InputIterator first, InputIterator last,
+							   typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			return _tree.insert_equal(first, last);
+		}
+
+		void			erase(iterator pos)						{ return _tree.erase((tree_iter &)pos); }
+		size_type		erase(key_type const & key)				{ return _tree.erase(key); }
+		void			erase(iterator first, iterator last)	{ return _tree.erase((tree_iter &)first, (tree_iter &)last); }
+		void			erase_below(key_type const & key)		{ _tree.erase_below(key); }
+		void			erase_above(key_type const & key)		{ _tree.erase_above(key); }
+		void			clear()									{ _tree.clear(); }
+
+		void			swap(multiset & s)						{ _tree.swap(s._tree); }
+
+	// Observers
+		allocator_type	get_allocator() const					{ return _tree.get_allocator(); }
+		key_compare		key_comp() const						{ return _tree.key_comp(); }
+		value_compare	value_comp() const						{ return _tree.key_comp(); }
+
+	// Operations
+		iterator		find(key_type const & key) const		{ return _tree.find(key); }
+		size_type		count(key_type const & key) const		{ return _tree.count(key); }
+		iterator		lower_bound(key_type const & key) const	{ return _tree.lower_bound(key); }
+		iterator		upper_bound(key_type const & key) const	{ return _tree.upper_bound(key); }
+
+		pair<iterator,iterator>					equal_range(key_type const & key) const {
+			return _tree.equal_range(key);
+		}
+
+	// Non-member overloads
+	public:
+		friend	bool	operator == (multiset const & lhs, multiset const & rhs) {
+			return lhs._tree == rhs._tree;
+		}
+		friend	bool	operator != (multiset const & lhs, multiset const & rhs) {
+			return lhs._tree != rhs._tree;
+		}
+		friend	bool	operator < (multiset const & lhs, multiset const & rhs) {
+			return lhs._tree < rhs._tree;
+		}
+		friend	bool	operator <= (multiset const & lhs, multiset const & rhs) {
+			return lhs._tree <= rhs._tree;
+		}
+		friend	bool	operator > (multiset const & lhs, multiset const & rhs) {
+			return lhs._tree > rhs._tree;
+		}
+		friend	bool	operator >= (multiset const & lhs, multiset const & rhs) {
+			return lhs._tree >= rhs._tree;
+		}
+};
+
+	template < class Key, class Comp, class Alloc >
+	void		swap(multiset<Key, Comp, Alloc> & lhs, multiset<Key, Comp, Alloc> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+// Walks a grouped_multiset: every key of the group is yielded once per copy
+template < class GroupIterator, class Key >
+class	counted_iterator
+{
+	public:
+		typedef bidirectional_iterator_tag	iterator_category;
+		typedef Key							value_type;
+		typedef Key const &					reference;
+		typedef Key const *					pointer;
+		typedef ptrdiff_t					difference_type;
+
+	private:
+		GroupIterator	_group;
+		size_t			_index;
+
+	public:
+		counted_iterator()										: _group(), _index(0)			{ }
+		counted_iterator(GroupIterator group, size_t index)		: _group(group), _index(index)	{ }
+
+		GroupIterator	group() const		{ return _group; }
+		size_t			index() const		{ return _index; }
+
+		reference		operator * () const		{ return (*_group).first; }
+		pointer			operator -> () const	{ return &(*_group).first; }
+
+		counted_iterator &	operator ++ ()
+		{
+			if (++_index == (*_group).second) {
+				++_group;
+				_index = 0;
+			}
+			return *this;
+		}
+
+		counted_iterator	operator ++ (int)
+		{
+			counted_iterator	tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		counted_iterator &	operator -- ()
+		{
+			if (_index == 0) {
+				--_group;
+				_index = (*_group).second;
+			}
+			--_index;
+			return *this;
+		}
+
+		counted_iterator	operator -- (int)
+		{
+			counted_iterator	tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		friend	bool	operator == (counted_iterator const & lhs, counted_iterator const & rhs) {
+			return lhs._group == rhs._group && lhs._index == rhs._index;
+		}
+		friend	bool	operator != (counted_iterator const & lhs, counted_iterator const & rhs) {
+			return !(lhs == rhs);
+		}
+};
+
+// Multiset storing each distinct key once with its number of copies:
+// duplicates cost a counter increment instead of a tree node, and count
+// and equal_range are O(log n). Equivalent keys are not kept apart, the
+// first one inserted stands for all of them.
+template	<	class Key,
+				class Compare = less<Key>,
+				class Allocator = std::allocator<Key>
+			>
+class	grouped_multiset
+{
+	// Type definitions
+	public:
+		typedef Key											key_type;
+		typedef Key											value_type;
+		typedef Compare										key_compare;
+		typedef Compare										value_compare;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::reference			reference;
+		typedef typename allocator_type::const_reference	const_reference;
+		typedef typename allocator_type::pointer			pointer;
+		typedef typename allocator_type::const_pointer		const_pointer;
+		typedef typename allocator_type::size_type			size_type;
+		typedef typename allocator_type::difference_type	difference_type;
+
+	private:
+		typedef pair<key_type const, size_type>									group_type;
+		typedef typename Allocator::template rebind<group_type>::other			group_allocator;
+		typedef ft::map<key_type, size_type, key_compare, group_allocator>		group_map;
+
+	public:
+		typedef counted_iterator<typename group_map::const_iterator, value_type>	iterator;
+		typedef iterator															const_iterator;
+		typedef ft::reverse_iterator<iterator>										reverse_iterator;
+		typedef reverse_iterator													const_reverse_iterator;
+
+	// Private members
+	private:
+		group_map		_groups;
+		size_type		_size;
+
+	// Constructors
+	public:
+		explicit grouped_multiset (key_compare const & comp = key_compare(),
+								   allocator_type const & alloc = allocator_type())
+			: _groups(comp, group_allocator(alloc)), _size(0)		{ }
+
+		template < class InputIterator >
+		grouped_multiset (InputIterator first, InputIterator last,
+						  key_compare const & comp = key_compare(),
+						  allocator_type const & alloc = allocator_type(),
+						  typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+			: _groups(comp, group_allocator(alloc)), _size(0)
+		{
+			insert(first, last);
+		}
+
+		~grouped_multiset ()										{ }
+
+	// Iterators
+		iterator			begin() const		{ return iterator(_groups.begin(), 0); }
+		iterator			end() const			{ return iterator(_groups.end(), 0); }
+		reverse_iterator	rbegin() const		{ return reverse_iterator(end()); }
+		reverse_iterator	rend() const		{ return reverse_iterator(begin()); }
+
+	// Capacity
+		bool				empty() const		{ return _size == 0; }
+		size_type			size() const		{ return _size; }
+		size_type			max_size() const	{ return size_type(-1); }
+		size_type			groups() const		{ return _groups.size(); }
+
+	// Modifiers
+		iterator		insert(value_type const & value)
+		{
+			typename group_map::iterator	g = _groups.lower_bound(value);
+
+			if (g == _groups.end() || key_comp()(value, (*g).first)) {
+				g = _groups.insert(g, group_type(value, 0));
+			}
+			_size++;
+			return iterator(g, (*g).second++);
+		}
+
+		iterator		insert(iterator, value_type const & value)
+		{
+			return insert(value);
+		}
+
+		template < class InputIterator >
+		void			insert(InputIterator first, InputIterator last,
+							   typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			while (first != last) {
+				insert(*first++);
+			}
+		}
+
+		void			erase(iterator pos)
+		{
+			typename group_map::iterator	g = _groups.find(*pos);
+
+			_size--;
+			if (--(*g).second == 0) {
+				_groups.erase(g);
+			}
+		}
+
+		size_type		erase(key_type const & key)
+		{
+			typename group_map::iterator	g = _groups.find(key);
+
+			if (g == _groups.end()) {
+				return 0;
+			}
+
+			size_type const	count = (*g).second;
+
+			_groups.erase(g);
+			_size -= count;
+			return count;
+		}
+
+		void			erase(iterator first, iterator last)
+		{
+			while (first != last) {
+				typename group_map::iterator	g = _groups.find(*first);
+				typename group_map::iterator	next = g;
+				bool const						in_group = last.group() == first.group();
+				size_type const					count = (in_group ? last.index() : (*g).second) - first.index();
+
+				++next;
+				_size -= count;
+				(*g).second -= count;
+				if ((*g).second == 0) {
+					_groups.erase(g);
+				}
+				if (in_group) {
+					return ;
+				}
+				first = iterator(next, 0);
+			}
+		}
+
+		void			clear()
+		{
+			_groups.clear();
+			_size = 0;
+		}
+
+		void			swap(grouped_multiset & other)
+		{
+			_groups.swap(other._groups);
+			std::swap(_size, other._size);
+		}
+
+	// Observers
+		allocator_type	get_allocator() const					{ return allocator_type(_groups.get_allocator()); }
+		key_compare		key_comp() const						{ return _groups.key_comp(); }
+		value_compare	value_comp() const						{ return _groups.key_comp(); }
+
+	// Operations
+		iterator		find(key_type const & key) const		{ return iterator(_groups.find(key), 0); }
+
+		size_type		count(key_type const & key) const
+		{
+			typename group_map::const_iterator	g = _groups.find(key);
+
+			return g == _groups.end() ? 0 : (*g).second;
+		}
+
+		iterator		lower_bound(key_type const & key) const	{ return iterator(_groups.lower_bound(key), 0); }
+		iterator		upper_bound(key_type const & key) const	{ return iterator(_groups.upper_bound(key), 0); }
+
+		pair<iterator,iterator>					equal_range(key_type const & key) const {
+			return pair<iterator,iterator>(lower_bound(key), upper_bound(key));
+		}
+
+	// Non-member overloads
+	public:
+		friend	bool	operator == (grouped_multiset const & lhs, grouped_multiset const & rhs) {
+			return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+		}
+		friend	bool	operator != (grouped_multiset const & lhs, grouped_multiset const & rhs) {
+			return !(lhs == rhs);
+		}
+		friend	bool	operator < (grouped_multiset const & lhs, grouped_multiset const & rhs) {
+			return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+		friend	bool	operator <= (grouped_multiset const & lhs, grouped_multiset const & rhs) {
+			return !(rhs < lhs);
+		}
+		friend	bool	operator > (grouped_multiset const & lhs, grouped_multiset const & rhs) {
+			return rhs < lhs;
+		}
+		friend	bool	operator >= (grouped_multiset const & lhs, grouped_multiset const & rhs) {
+			return !(lhs < rhs);
+		}
+};
+
+	template < class Key, class Comp, class Alloc >
+	void		swap(grouped_multiset<Key, Comp, Alloc> & lhs, grouped_multiset<Key, Comp, Alloc> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
+
+
+#endif
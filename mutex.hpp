@@ -0,0 +1,128 @@
+#ifndef FT_MUTEX_HPP
+# define FT_MUTEX_HPP
+
+# include <stdexcept>
+
+# include <pthread.h>
+# include <sys/time.h>
+
+namespace	ft
+
+{
+
+// pthread mutex, reader-writer lock and condition variable with scoped
+// guards, for the concurrent containers; C++98 has no standard threading
+// library
+
+class	mutex
+{
+	pthread_mutex_t		_m;
+
+	mutex(mutex const &);
+	mutex &	operator = (mutex const &);
+
+	public:
+		mutex()
+		{
+			if (pthread_mutex_init(&_m, NULL) != 0) {
+				throw std::runtime_error("mutex::mutex()::init_failed");
+			}
+		}
+
+		~mutex()				{ pthread_mutex_destroy(&_m); }
+
+		void	lock()			{ pthread_mutex_lock(&_m); }
+		bool	try_lock()		{ return pthread_mutex_trylock(&_m) == 0; }
+		void	unlock()		{ pthread_mutex_unlock(&_m); }
+
+		pthread_mutex_t *	native_handle()		{ return &_m; }
+};
+
+class	shared_mutex
+{
+	pthread_rwlock_t	_m;
+
+	shared_mutex(shared_mutex const &);
+	shared_mutex &	operator = (shared_mutex const &);
+
+	public:
+		shared_mutex()
+		{
+			if (pthread_rwlock_init(&_m, NULL) != 0) {
+				throw std::runtime_error("shared_mutex::shared_mutex()::init_failed");
+			}
+		}
+
+		~shared_mutex()			{ pthread_rwlock_destroy(&_m); }
+
+		void	lock()			{ pthread_rwlock_wrlock(&_m); }
+		void	unlock()		{ pthread_rwlock_unlock(&_m); }
+		void	lock_shared()	{ pthread_rwlock_rdlock(&_m); }
+		void	unlock_shared()	{ pthread_rwlock_unlock(&_m); }
+};
+
+class	condition_variable
+{
+	pthread_cond_t		_c;
+
+	condition_variable(condition_variable const &);
+	condition_variable &	operator = (condition_variable const &);
+
+	public:
+		condition_variable()
+		{
+			if (pthread_cond_init(&_c, NULL) != 0) {
+				throw std::runtime_error("condition_variable::condition_variable()::init_failed");
+			}
+		}
+
+		~condition_variable()		{ pthread_cond_destroy(&_c); }
+
+		// m must be locked; it is again when these return, spuriously or not
+		void	wait(mutex & m)		{ pthread_cond_wait(&_c, m.native_handle()); }
+
+		void	wait_for(mutex & m, long microseconds)
+		{
+			struct timeval	now;
+			struct timespec	deadline;
+
+			gettimeofday(&now, NULL);
+			microseconds += now.tv_usec;
+			deadline.tv_sec = now.tv_sec + microseconds / 1000000;
+			deadline.tv_nsec = microseconds % 1000000 * 1000;
+			pthread_cond_timedwait(&_c, m.native_handle(), &deadline);
+		}
+
+		void	notify_one()		{ pthread_cond_signal(&_c); }
+		void	notify_all()		{ pthread_cond_broadcast(&_c); }
+};
+
+template < class Mutex >
+class	lock_guard
+{
+	Mutex &		_m;
+
+	lock_guard(lock_guard const &);
+	lock_guard &	operator = (lock_guard const &);
+
+	public:
+		explicit lock_guard(Mutex & m) : _m(m)	{ _m.lock(); }
+		~lock_guard()							{ _m.unlock(); }
+};
+
+template < class Mutex >
+class	shared_lock_guard
+{
+	Mutex &		_m;
+
+	shared_lock_guard(shared_lock_guard const &);
+	shared_lock_guard &	operator = (shared_lock_guard const &);
+
+	public:
+		explicit shared_lock_guard(Mutex & m) : _m(m)	{ _m.lock_shared(); }
+		~shared_lock_guard()							{ _m.unlock_shared(); }
+};
+
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef FT_PARALLEL_MAP_HPP
+# define FT_PARALLEL_MAP_HPP
+
+# include "map.hpp"
+# include "set.hpp"
+# include "thread_pool.hpp"
+# include "utils.hpp"
+# include "vector.hpp"
+
+namespace	ft
+
+{
+
+// Parallel bulk load and traversal of ft::map and ft::set on a thread_pool
+
+// Hands the blocks of a tree to parallel_for (see RedBlackTree::assign_sorted_unique)
+struct	_pool_blocks
+{
+	thread_pool *	pool;
+
+	explicit _pool_blocks(thread_pool & pool) : pool(&pool)		{ }
+
+	template < class Function >
+	void	operator () (size_t n, Function f, size_t grain) const
+	{
+		parallel_for(*pool, n, f, grain);
+	}
+};
+
+template < class Value, class KeyOfValue, class Compare >
+struct	_address_compare
+{
+	Compare		comp;
+
+	explicit _address_compare(Compare const & comp) : comp(comp)		{ }
+
+	bool	operator () (Value const * lhs, Value const * rhs) const
+	{
+		return comp(KeyOfValue()(*lhs), KeyOfValue()(*rhs));
+	}
+};
+
+// The input is staged, its addresses stable sorted on pool and the
+// duplicates dropped, first one kept, as insert would; the tree is then
+// linked on pool from the sorted positions
+template < class KeyOfValue, class Container, class InputIterator >
+void	_bulk_load(thread_pool & pool, Container & c, InputIterator first, InputIterator last)
+{
+	typedef typename Container::value_type	value_type;
+	typedef typename Container::key_compare	key_compare;
+
+	ft::vector<value_type>			staged(first, last);
+	ft::vector<value_type const *>	sorted(staged.size());
+	key_compare const				comp = c.key_comp();
+	size_t							count = 0;
+
+	for (size_t i = 0; i < staged.size(); i++) {
+		sorted[i] = &staged[i];
+	}
+	parallel_sort(pool, sorted.data(), sorted.data() + sorted.size(),
+				  _address_compare<value_type, KeyOfValue, key_compare>(comp));
+	for (size_t i = 0; i < sorted.size(); i++) {
+		if (count == 0 || comp(KeyOfValue()(*sorted[count - 1]), KeyOfValue()(*sorted[i]))) {
+			sorted[count++] = sorted[i];
+		}
+	}
+	c.assign_sorted_unique(sorted.data(), count, _pool_blocks(pool));
+}
+
+// Replaces the contents of m with [first, last), sorted and linked on
+// pool; the first of equal keys wins
+template < class Key, class T, class Compare, class Alloc, class InputIterator >
+void	bulk_load(thread_pool & pool, map<Key, T, Compare, Alloc> & m,
+				  InputIterator first, InputIterator last)
+{
+	typedef typename map<Key, T, Compare, Alloc>::value_type	value_type;
+
+	_bulk_load< select1st<value_type> >(pool, m, first, last);
+}
+
+template < class Key, class Compare, class Alloc, class InputIterator >
+void	bulk_load(thread_pool & pool, set<Key, Compare, Alloc> & s,
+				  InputIterator first, InputIterator last)
+{
+	_bulk_load< identity<Key> >(pool, s, first, last);
+}
+
+// f sees every element once, from the workers of pool, each going through
+// its own subtrees in order; f must be safe to call concurrently
+template < class Key, class T, class Compare, class Alloc, class Function >
+void	parallel_for_each(thread_pool & pool, map<Key, T, Compare, Alloc> & m, Function f)
+{
+	m.parallel_for_each(_pool_blocks(pool), f);
+}
+
+template < class Key, class T, class Compare, class Alloc, class Function >
+void	parallel_for_each(thread_pool & pool, map<Key, T, Compare, Alloc> const & m, Function f)
+{
+	m.parallel_for_each(_pool_blocks(pool), f);
+}
+
+template < class Key, class Compare, class Alloc, class Function >
+void	parallel_for_each(thread_pool & pool, set<Key, Compare, Alloc> const & s, Function f)
+{
+	s.parallel_for_each(_pool_blocks(pool), f);
+}
+
+}
+
+#endif
@@ -0,0 +1,404 @@
+#ifndef FT_PRIORITY_QUEUE_HPP
+# define FT_PRIORITY_QUEUE_HPP
+
+# include <algorithm>
+# include <cstddef>
+# include <stdexcept>
+
+# include "vector.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+// d-ary heap over any container with operator [], push_back and pop_back
+//
+// Every node has Arity children stored next to each other, so a heap of n
+// elements is log_Arity(n) levels deep instead of log_2(n): a pop compares
+// more children per level but misses the cache on far fewer levels, and
+// with 4 children of a small T one level fits in one cache line. Every time
+// an element lands on an index, placed(index) is called, which lets the
+// indexed queue keep track of where its elements are.
+template < size_t Arity >
+struct	d_ary_heap
+{
+	typedef char	_requires_two_children[Arity >= 2 ? 1 : -1];
+
+	static size_t	parent(size_t i)		{ return (i - 1) / Arity; }
+	static size_t	first_child(size_t i)	{ return i * Arity + 1; }
+
+	template < class Sequence, class Compare, class Placed >
+	static void		sift_up(Sequence & c, size_t i, Compare & comp, Placed & placed)
+	{
+		typename Sequence::value_type	value = c[i];
+
+		while (i > 0 && comp(c[parent(i)], value)) {
+			c[i] = c[parent(i)];
+			placed(i);
+			i = parent(i);
+		}
+		c[i] = value;
+		placed(i);
+	}
+
+	template < class Sequence, class Compare, class Placed >
+	static void		sift_down(Sequence & c, size_t n, size_t i, Compare & comp, Placed & placed)
+	{
+		typename Sequence::value_type	value = c[i];
+
+		for (;;) {
+			size_t const	first = first_child(i);
+
+			if (first >= n) {
+				break ;
+			}
+
+			size_t const	last = n - first > Arity ? first + Arity : n;
+			size_t			best = first;
+
+			for (size_t j = first + 1; j < last; j++) {
+				if (comp(c[best], c[j])) {
+					best = j;
+				}
+			}
+			if (!comp(value, c[best])) {
+				break ;
+			}
+			c[i] = c[best];
+			placed(i);
+			i = best;
+		}
+		c[i] = value;
+		placed(i);
+	}
+
+	// Floyd's heap construction, O(n): every inner node, bottom up, sifted down
+	template < class Sequence, class Compare, class Placed >
+	static void		make(Sequence & c, size_t n, Compare & comp, Placed & placed)
+	{
+		if (n < 2) {
+			return ;
+		}
+		for (size_t i = parent(n - 1) + 1; i > 0; i--) {
+			sift_down(c, n, i - 1, comp, placed);
+		}
+	}
+
+	struct	untracked
+	{
+		void	operator () (size_t) const		{ }
+	};
+};
+
+// Top is the element no other compares after, the largest with ft::less
+// and the smallest with ft::greater, as std::priority_queue
+template <	class T, class Container = ft::vector<T>,
+			class Compare = ft::less<typename Container::value_type>, size_t Arity = 4 >
+class	priority_queue
+{
+	public:
+		typedef Container								container_type;
+		typedef Compare									value_compare;
+		typedef typename Container::value_type			value_type;
+		typedef typename Container::size_type			size_type;
+		typedef typename Container::reference			reference;
+		typedef typename Container::const_reference		const_reference;
+
+	private:
+		typedef d_ary_heap<Arity>				_heap;
+		typedef typename _heap::untracked		_untracked;
+
+	protected:
+		container_type		c;
+		value_compare		comp;
+
+	public:
+		explicit priority_queue(value_compare const & compare = value_compare(),
+								container_type const & cont = container_type())
+			: c(cont), comp(compare)
+		{
+			_make();
+		}
+
+		template < class InputIterator >
+		priority_queue(InputIterator first, InputIterator last,
+					   value_compare const & compare = value_compare(),
+					   container_type const & cont = container_type())
+			: c(cont), comp(compare)
+		{
+			while (first != last) {
+				c.push_back(*first++);
+			}
+			_make();
+		}
+
+		priority_queue(priority_queue const & other) : c(other.c), comp(other.comp)	{ }
+
+		priority_queue &	operator = (priority_queue const & other)
+		{
+			c = other.c;
+			comp = other.comp;
+			return *this;
+		}
+
+		~priority_queue() { }
+
+	public:
+		bool				empty() const					{ return c.empty(); }
+		size_type			size() const					{ return c.size(); }
+
+		const_reference		top() const						{ return c.front(); }
+
+		void				push(value_type const & value)
+		{
+			_untracked	placed;
+
+			c.push_back(value);
+			_heap::sift_up(c, c.size() - 1, comp, placed);
+		}
+
+		// Appends [first, last) and restores the heap once: by sifting the
+		// new elements up when they are few, by rebuilding it in O(n) when
+		// they are at least as many as the ones already queued
+		template < class InputIterator >
+		void				push_range(InputIterator first, InputIterator last)
+		{
+			_untracked		placed;
+			size_type const	old_size = c.size();
+
+			while (first != last) {
+				c.push_back(*first++);
+			}
+			if (c.size() - old_size >= old_size) {
+				_make();
+			}
+			else {
+				for (size_type i = old_size; i < c.size(); i++) {
+					_heap::sift_up(c, i, comp, placed);
+				}
+			}
+		}
+
+		void				pop()
+		{
+			_untracked	placed;
+
+			c.front() = c.back();
+			c.pop_back();
+			if (!c.empty()) {
+				_heap::sift_down(c, c.size(), 0, comp, placed);
+			}
+		}
+
+		void				swap(priority_queue & other)
+		{
+			c.swap(other.c);
+			std::swap(comp, other.comp);
+		}
+
+	private:
+		void				_make()
+		{
+			_untracked	placed;
+
+			_heap::make(c, c.size(), comp, placed);
+		}
+};
+
+template < class T, class Container, class Compare, size_t Arity >
+void	swap(priority_queue<T, Container, Compare, Arity> & lhs,
+			 priority_queue<T, Container, Compare, Arity> & rhs)
+{
+	lhs.swap(rhs);
+}
+
+// Priority queue whose elements can be reached after they were pushed
+//
+// push returns a handle that stays valid until its element is popped or
+// erased; handles are reused afterwards. Through it an element can be read,
+// given a new priority or removed in O(log n), e.g. a timer rescheduled or
+// cancelled, at the cost of one position table entry per handle.
+template < class T, class Compare = ft::less<T>, size_t Arity = 4 >
+class	indexed_priority_queue
+{
+	public:
+		typedef T						value_type;
+		typedef Compare					value_compare;
+		typedef size_t					size_type;
+		typedef size_t					handle_type;
+		typedef value_type const &		const_reference;
+
+	private:
+		typedef d_ary_heap<Arity>		_heap;
+
+		struct	entry
+		{
+			value_type		value;
+			handle_type		handle;
+
+			entry(value_type const & value, handle_type handle) : value(value), handle(handle)	{ }
+		};
+
+		struct	entry_compare
+		{
+			value_compare	comp;
+
+			explicit entry_compare(value_compare const & comp) : comp(comp)	{ }
+
+			bool	operator () (entry const & lhs, entry const & rhs)
+			{
+				return comp(lhs.value, rhs.value);
+			}
+		};
+
+		struct	tracker
+		{
+			ft::vector<entry> *		heap;
+			ft::vector<size_type> *	positions;
+
+			void	operator () (size_type i)		{ (*positions)[(*heap)[i].handle] = i; }
+		};
+
+		static const size_type	_free = static_cast<size_type>(-1);
+
+		ft::vector<entry>			_heap_entries;
+		ft::vector<size_type>		_positions;		// by handle, _free when unused
+		ft::vector<handle_type>		_free_handles;
+		entry_compare				_comp;
+
+	public:
+		explicit indexed_priority_queue(value_compare const & compare = value_compare())
+			: _comp(compare)													{ }
+
+		bool				empty() const				{ return _heap_entries.empty(); }
+		size_type			size() const				{ return _heap_entries.size(); }
+
+		const_reference		top() const					{ return _heap_entries.front().value; }
+		handle_type			top_handle() const			{ return _heap_entries.front().handle; }
+
+		bool				contains(handle_type h) const
+		{
+			return h < _positions.size() && _positions[h] != _free;
+		}
+
+		const_reference		value(handle_type h) const
+		{
+			return _heap_entries[_position(h, "indexed_priority_queue::value()::out_of_range")].value;
+		}
+
+		handle_type			push(value_type const & value)
+		{
+			if (_free_handles.empty()) {
+				_positions.push_back(_free);
+				_free_handles.push_back(_positions.size() - 1);
+			}
+
+			handle_type const	h = _free_handles.back();
+			tracker				placed = _tracker();
+
+			_heap_entries.push_back(entry(value, h));
+			_free_handles.pop_back();
+
+			_heap::sift_up(_heap_entries, _heap_entries.size() - 1, _comp, placed);
+			return h;
+		}
+
+		void				pop()
+		{
+			_remove(0);
+		}
+
+		void				erase(handle_type h)
+		{
+			_remove(_position(h, "indexed_priority_queue::erase()::out_of_range"));
+		}
+
+		// Gives h's element a new value and moves it whichever way it now goes
+		void				update(handle_type h, value_type const & value)
+		{
+			_assign(_position(h, "indexed_priority_queue::update()::out_of_range"), value);
+		}
+
+		// update for a value that moves toward the top, a smaller key with
+		// ft::greater as in Dijkstra's or a timer brought forward; a value
+		// that ranks lower instead still sinks to its place
+		void				decrease_key(handle_type h, value_type const & value)
+		{
+			_assign(_position(h, "indexed_priority_queue::decrease_key()::out_of_range"), value);
+		}
+
+		void				clear()
+		{
+			_heap_entries.clear();
+			_positions.clear();
+			_free_handles.clear();
+		}
+
+	private:
+		indexed_priority_queue(indexed_priority_queue const &);
+		indexed_priority_queue &	operator = (indexed_priority_queue const &);
+
+		tracker				_tracker()
+		{
+			tracker	t = { &_heap_entries, &_positions };
+
+			return t;
+		}
+
+		size_type			_position(handle_type h, char const * error) const
+		{
+			if (!contains(h)) {
+				throw std::out_of_range(error);
+			}
+			return _positions[h];
+		}
+
+		void				_assign(size_type i, value_type const & value)
+		{
+			bool const	rises = _comp.comp(_heap_entries[i].value, value);
+			tracker		placed = _tracker();
+
+			_heap_entries[i].value = value;
+			if (rises) {
+				_heap::sift_up(_heap_entries, i, _comp, placed);
+			}
+			else {
+				_heap::sift_down(_heap_entries, _heap_entries.size(), i, _comp, placed);
+			}
+		}
+
+		// The last element fills the hole at i and goes up or down from there
+		void				_remove(size_type i)
+		{
+			handle_type const	h = _heap_entries[i].handle;
+			size_type const		last = _heap_entries.size() - 1;
+
+			_free_handles.push_back(h);
+			_positions[h] = _free;
+			if (i != last) {
+				tracker		placed = _tracker();
+				bool const	rises = _comp(_heap_entries[i], _heap_entries[last]);
+
+				_heap_entries[i] = _heap_entries[last];
+				_heap_entries.pop_back();
+				if (rises) {
+					_heap::sift_up(_heap_entries, i, _comp, placed);
+				}
+				else {
+					_heap::sift_down(_heap_entries, _heap_entries.size(), i, _comp, placed);
+				}
+			}
+			else {
+				_heap_entries.pop_back();
+			}
+		}
+};
+
+template < class T, class Compare, size_t Arity >
+typename indexed_priority_queue<T, Compare, Arity>::size_type const
+	indexed_priority_queue<T, Compare, Arity>::_free;
+
+}
+
+#endif
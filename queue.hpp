@@ -0,0 +1,54 @@
+#ifndef FT_QUEUE_HPP
+# define FT_QUEUE_HPP
+
+# include "deque.hpp"
+
+namespace	ft
+
+{
+
+template < class T, class Container = ft::deque<T> >
+class	queue
+{
+	public:
+		typedef Container								container_type;
+		typedef typename Container::value_type			value_type;
+		typedef typename Container::size_type			size_type;
+		typedef typename Container::reference			reference;
+		typedef typename Container::const_reference		const_reference;
+
+	protected:
+		container_type		c;
+
+	public:
+		explicit queue(const container_type & cont = container_type()) : c(cont) { }
+		queue(queue const & other) : c(other.c) { }
+
+		queue &		operator = (queue const & other)  { c = other.c; return *this; }
+
+		~queue() { }
+
+	public:
+		bool				empty() const					{ return c.empty(); }
+		size_type			size() const					{ return c.size(); }
+
+		reference			front()							{ return c.front(); }
+		const_reference		front() const					{ return c.front(); }
+		reference			back()							{ return c.back(); }
+		const_reference		back() const					{ return c.back(); }
+		void				push(value_type const & value)	{ return c.push_back(value); }
+		void				pop()							{ c.pop_front(); }
+
+	public:
+		friend	bool	operator == (queue const & lhs, queue const & rhs)	{ return lhs.c == rhs.c; }
+		friend	bool	operator != (queue const & lhs, queue const & rhs)	{ return lhs.c != rhs.c; }
+		friend	bool	operator < (queue const & lhs, queue const & rhs)	{ return lhs.c < rhs.c; }
+		friend	bool	operator <= (queue const & lhs, queue const & rhs)	{ return lhs.c <= rhs.c; }
+		friend	bool	operator > (queue const & lhs, queue const & rhs)	{ return lhs.c > rhs.c; }
+		friend	bool	operator >= (queue const & lhs, queue const & rhs)	{ return lhs.c >= rhs.c; }
+
+};
+
+}
+
+#endif
@@ -0,0 +1,337 @@
+#ifndef FT_RING_HPP
+# define FT_RING_HPP
+
+# include <memory>
+# include <stdexcept>
+
+# include "atomic.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+// Bounded lock-free FIFOs over one contiguous array of a power of two of
+// slots, for handing values between pipeline threads. Indices grow without
+// wrapping and are masked into the array; the producer's and consumer's
+// indices live on separate cache lines so each side only ever writes its
+// own. try_push fails when the ring is full, try_pop when it is empty;
+// push and pop spin until they succeed.
+
+// Single producer, single consumer
+//
+// Each side keeps a private copy of the other's index and only reloads it
+// when that copy says the ring is full (or empty): in steady state a
+// handoff costs one store and no cache miss on the shared index
+template < class T, class Allocator = std::allocator<T> >
+class	spsc_ring
+{
+	// Type definitions
+	public:
+		typedef T											value_type;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::size_type			size_type;
+		typedef value_type &								reference;
+		typedef value_type const &							const_reference;
+
+	// Private members
+	private:
+		struct	producer
+		{
+			size_type	tail;			// next slot to fill
+			size_type	head_cache;
+		};
+
+		struct	consumer
+		{
+			size_type	head;			// next slot to drain
+			size_type	tail_cache;
+		};
+
+		struct	layout
+		{
+			T *			buffer;
+			size_type	mask;
+		};
+
+		padded<layout>		_ring;
+		padded<producer>	_producer;
+		padded<consumer>	_consumer;
+		allocator_type		_alloc;
+
+	// Constructors
+	public:
+		// capacity is rounded up to a power of two
+		explicit spsc_ring (size_type capacity,
+							allocator_type const & alloc = allocator_type())
+			: _alloc(alloc)
+		{
+			size_type	n = 1;
+
+			if (capacity > _alloc.max_size())
+				throw std::length_error("spsc_ring::spsc_ring()::length_error");
+			while (n < capacity) {
+				n <<= 1;
+			}
+			_ring.value.buffer = _alloc.allocate(n);
+			_ring.value.mask = n - 1;
+			_producer.value.tail = 0;
+			_producer.value.head_cache = 0;
+			_consumer.value.head = 0;
+			_consumer.value.tail_cache = 0;
+		}
+
+		// Neither side may be running
+		~spsc_ring()
+		{
+			for (size_type i = _consumer.value.head; i != _producer.value.tail; i++) {
+				_alloc.destroy(_ring.value.buffer + (i & _ring.value.mask));
+			}
+			_alloc.deallocate(_ring.value.buffer, _ring.value.mask + 1);
+		}
+
+	// Capacity
+		size_type		capacity() const	{ return _ring.value.mask + 1; }
+
+		// Exact on either side's thread, a hint anywhere else
+		size_type		size() const
+		{
+			return atomic_load(&_producer.value.tail, memory_order_acquire)
+				- atomic_load(&_consumer.value.head, memory_order_acquire);
+		}
+
+		bool			empty() const		{ return size() == 0; }
+
+	// Producer
+		bool			try_push(value_type const & value)
+		{
+			producer &			p = _producer.value;
+			size_type const		tail = p.tail;
+
+			if (tail - p.head_cache > _ring.value.mask) {
+				p.head_cache = atomic_load(&_consumer.value.head, memory_order_acquire);
+				if (tail - p.head_cache > _ring.value.mask) {
+					return false;
+				}
+			}
+			_alloc.construct(_ring.value.buffer + (tail & _ring.value.mask), value);
+			atomic_store(&p.tail, tail + 1, memory_order_release);
+			return true;
+		}
+
+		void			push(value_type const & value)
+		{
+			while (!try_push(value)) {
+				cpu_relax();
+			}
+		}
+
+	// Consumer
+		bool			try_pop(value_type & value)
+		{
+			consumer &			c = _consumer.value;
+			size_type const		head = c.head;
+
+			if (head == c.tail_cache) {
+				c.tail_cache = atomic_load(&_producer.value.tail, memory_order_acquire);
+				if (head == c.tail_cache) {
+					return false;
+				}
+			}
+
+			T *		slot = _ring.value.buffer + (head & _ring.value.mask);
+
+			value = *slot;
+			_alloc.destroy(slot);
+			atomic_store(&c.head, head + 1, memory_order_release);
+			return true;
+		}
+
+		void			pop(value_type & value)
+		{
+			while (!try_pop(value)) {
+				cpu_relax();
+			}
+		}
+
+		allocator_type	get_allocator() const	{ return _alloc; }
+
+	// Private member functions
+	private:
+		spsc_ring (spsc_ring const &);
+		spsc_ring &	operator = (spsc_ring const &);
+
+};
+
+// Multiple producers, multiple consumers (Vyukov's bounded queue)
+//
+// Every slot carries a sequence number telling which lap of the ring it is
+// ready for: a producer claims position pos when its slot's sequence is pos,
+// a consumer when it is pos + 1. Claims are one compare and exchange on the
+// shared index, the value itself is handed over through the slot's sequence
+// alone. T's copy constructor and assignment must not throw: a claimed slot
+// can not be given back
+template < class T, class Allocator = std::allocator<T> >
+class	mpmc_ring
+{
+	// Type definitions
+	public:
+		typedef T											value_type;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::size_type			size_type;
+		typedef typename allocator_type::difference_type	difference_type;
+		typedef value_type &								reference;
+		typedef value_type const &							const_reference;
+
+	// Private members
+	private:
+		struct	cell
+		{
+			size_type				sequence;
+			aligned_buffer<T, 1>	storage;
+		};
+
+		typedef typename Allocator::template rebind<cell>::other	cell_allocator;
+
+		struct	layout
+		{
+			cell *		cells;
+			size_type	mask;
+		};
+
+		padded<layout>		_ring;
+		padded<size_type>	_tail;		// next position to fill
+		padded<size_type>	_head;		// next position to drain
+		allocator_type		_alloc;
+		cell_allocator		_cell_alloc;
+
+	// Constructors
+	public:
+		// capacity is rounded up to a power of two, at least 2
+		explicit mpmc_ring (size_type capacity,
+							allocator_type const & alloc = allocator_type())
+			: _alloc(alloc), _cell_alloc(alloc)
+		{
+			size_type	n = 2;
+
+			if (capacity > _cell_alloc.max_size())
+				throw std::length_error("mpmc_ring::mpmc_ring()::length_error");
+			while (n < capacity) {
+				n <<= 1;
+			}
+			_ring.value.cells = _cell_alloc.allocate(n);
+			_ring.value.mask = n - 1;
+			for (size_type i = 0; i < n; i++) {
+				_ring.value.cells[i].sequence = i;
+			}
+			_tail.value = 0;
+			_head.value = 0;
+		}
+
+		// No producer or consumer may be running
+		~mpmc_ring()
+		{
+			for (size_type i = _head.value; i != _tail.value; i++) {
+				_alloc.destroy(_ring.value.cells[i & _ring.value.mask].storage.ptr());
+			}
+			_cell_alloc.deallocate(_ring.value.cells, _ring.value.mask + 1);
+		}
+
+	// Capacity
+		size_type		capacity() const	{ return _ring.value.mask + 1; }
+
+		// Only a hint while other threads push and pop
+		size_type		size() const
+		{
+			size_type const	head = atomic_load(&_head.value, memory_order_relaxed);
+			size_type const	tail = atomic_load(&_tail.value, memory_order_relaxed);
+
+			return static_cast<difference_type>(tail - head) > 0 ? tail - head : 0;
+		}
+
+		bool			empty() const		{ return size() == 0; }
+
+	// Modifiers
+		bool			try_push(value_type const & value)
+		{
+			size_type	pos = atomic_load(&_tail.value, memory_order_relaxed);
+			cell *		c;
+
+			for (;;) {
+				c = _ring.value.cells + (pos & _ring.value.mask);
+
+				difference_type const	lap = static_cast<difference_type>(
+						atomic_load(&c->sequence, memory_order_acquire) - pos);
+
+				if (lap == 0) {
+					if (atomic_compare_exchange(&_tail.value, pos, pos + 1, memory_order_relaxed)) {
+						break ;
+					}
+				}
+				else if (lap < 0) {
+					return false;
+				}
+				else {
+					pos = atomic_load(&_tail.value, memory_order_relaxed);
+				}
+			}
+			_alloc.construct(c->storage.ptr(), value);
+			atomic_store(&c->sequence, pos + 1, memory_order_release);
+			return true;
+		}
+
+		void			push(value_type const & value)
+		{
+			while (!try_push(value)) {
+				cpu_relax();
+			}
+		}
+
+		bool			try_pop(value_type & value)
+		{
+			size_type	pos = atomic_load(&_head.value, memory_order_relaxed);
+			cell *		c;
+
+			for (;;) {
+				c = _ring.value.cells + (pos & _ring.value.mask);
+
+				difference_type const	lap = static_cast<difference_type>(
+						atomic_load(&c->sequence, memory_order_acquire) - (pos + 1));
+
+				if (lap == 0) {
+					if (atomic_compare_exchange(&_head.value, pos, pos + 1, memory_order_relaxed)) {
+						break ;
+					}
+				}
+				else if (lap < 0) {
+					return false;
+				}
+				else {
+					pos = atomic_load(&_head.value, memory_order_relaxed);
+				}
+			}
+			value = *c->storage.ptr();
+			_alloc.destroy(c->storage.ptr());
+			atomic_store(&c->sequence, pos + _ring.value.mask + 1, memory_order_release);
+			return true;
+		}
+
+		void			pop(value_type & value)
+		{
+			while (!try_pop(value)) {
+				cpu_relax();
+			}
+		}
+
+		allocator_type	get_allocator() const	{ return _alloc; }
+
+	// Private member functions
+	private:
+		mpmc_ring (mpmc_ring const &);
+		mpmc_ring &	operator = (mpmc_ring const &);
+
+};
+
+}
+
+#endif
@@ -0,0 +1,383 @@
+#ifndef FT_SEGMENTED_VECTOR_HPP
+# define FT_SEGMENTED_VECTOR_HPP
+
+# include <memory>
+# include <algorithm>
+# include <stdexcept>
+
+# include "iterator.hpp"
+# include "utils.hpp"
+# include "vector.hpp"
+
+namespace	ft
+
+{
+
+// Iterators
+// Keeps a pointer to the chunk index and an element position, so it
+// survives growth of the index itself and follows the elements on swap
+template < class Index, class T, size_t ChunkSize >
+class	segmented_iterator
+{
+	public:
+		typedef random_access_iterator_tag	iterator_category;
+		typedef T							value_type;
+		typedef ptrdiff_t					difference_type;
+		typedef T *							pointer;
+		typedef T &							reference;
+
+		typedef segmented_iterator			iter;
+
+	protected:
+		Index const *		_index;
+		difference_type		_pos;
+
+	public:
+		segmented_iterator() : _index(NULL), _pos(0)										{ }
+		segmented_iterator(Index const * index, difference_type pos)
+			: _index(index), _pos(pos)														{ }
+		template < class U >
+		segmented_iterator(segmented_iterator<Index, U, ChunkSize> const & other)
+			: _index(other.index()), _pos(other.position())								{ }
+		~segmented_iterator()																{ }
+
+		Index const *		index() const							{ return _index; }
+		difference_type		position() const						{ return _pos; }
+
+		reference			operator * () const						{ return (*_index)[_pos / ChunkSize][_pos % ChunkSize]; }
+		pointer				operator -> () const					{ return &(operator*()); }
+		reference			operator [] (difference_type n) const	{ return *(*this + n); }
+		iter &				operator ++ ()							{ _pos++; return *this; }
+		iter				operator ++ (int)						{ iter tmp(*this); _pos++; return tmp; }
+		iter				operator + (difference_type n) const	{ return iter(_index, _pos + n); }
+		iter &				operator += (difference_type n)			{ _pos += n; return *this; }
+		iter &				operator -- ()							{ _pos--; return *this; }
+		iter				operator -- (int)						{ iter tmp(*this); _pos--; return tmp; }
+		iter				operator - (difference_type n) const	{ return iter(_index, _pos - n); }
+		iter &				operator -= (difference_type n)			{ _pos -= n; return *this; }
+
+		friend iter		operator + (difference_type n, iter const & it)		{ return it + n; }
+
+		template < class U >
+		difference_type	operator - (segmented_iterator<Index, U, ChunkSize> const & rhs) const	{ return _pos - rhs.position(); }
+
+		template < class U >
+		bool			operator == (segmented_iterator<Index, U, ChunkSize> const & rhs) const	{ return _pos == rhs.position(); }
+		template < class U >
+		bool			operator != (segmented_iterator<Index, U, ChunkSize> const & rhs) const	{ return _pos != rhs.position(); }
+		template < class U >
+		bool			operator < (segmented_iterator<Index, U, ChunkSize> const & rhs) const	{ return _pos < rhs.position(); }
+		template < class U >
+		bool			operator > (segmented_iterator<Index, U, ChunkSize> const & rhs) const	{ return _pos > rhs.position(); }
+		template < class U >
+		bool			operator <= (segmented_iterator<Index, U, ChunkSize> const & rhs) const	{ return _pos <= rhs.position(); }
+		template < class U >
+		bool			operator >= (segmented_iterator<Index, U, ChunkSize> const & rhs) const	{ return _pos >= rhs.position(); }
+};
+
+// Vector stored as fixed-size chunks reached through a chunk index:
+// growing allocates one more chunk and never moves existing elements,
+// so their addresses stay valid until they are popped. The index lives
+// on the heap and swap exchanges it, so iterators keep pointing into the
+// same elements afterwards, as with the standard containers
+template <	class T, size_t ChunkSize = block_size<T>::value,
+			class Allocator = std::allocator<T>	>
+class	segmented_vector
+{
+	typedef typename Allocator::template rebind<T *>::other		index_allocator;
+	typedef ft::vector<T *, index_allocator>					chunk_index;
+	typedef typename Allocator::template rebind<chunk_index>::other	chunk_index_allocator;
+
+	// Type definitions
+	public:
+		typedef T											value_type;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::size_type			size_type;
+		typedef typename allocator_type::difference_type	difference_type;
+		typedef typename allocator_type::reference			reference;
+		typedef typename allocator_type::const_reference	const_reference;
+		typedef typename allocator_type::pointer			pointer;
+		typedef typename allocator_type::const_pointer		const_pointer;
+		typedef segmented_iterator<chunk_index, T, ChunkSize>			iterator;
+		typedef segmented_iterator<chunk_index, T const, ChunkSize>	const_iterator;
+		typedef ft::reverse_iterator<iterator>				reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+		static const size_type								chunk_size = ChunkSize;
+
+	// Private members
+	private:
+		chunk_index *	_chunks;
+		size_type		_size;
+		allocator_type	_alloc;
+
+	// Constructors
+	public:
+		explicit segmented_vector	(allocator_type const & alloc = allocator_type())
+			: _chunks(_new_index(alloc)), _size(0), _alloc(alloc)
+		{
+		}
+
+		explicit segmented_vector	(size_type count, value_type const & value = value_type(),
+									 allocator_type const & alloc = allocator_type())
+			: _chunks(_new_index(alloc)), _size(0), _alloc(alloc)
+		{
+			try {
+				assign(count, value);
+			}
+			catch (...) {
+				_abandon();
+				throw;
+			}
+		}
+
+		template < class InputIterator >
+		segmented_vector	(InputIterator first, InputIterator last,
+							 allocator_type const & alloc = allocator_type(),
+							 typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+			: _chunks(_new_index(alloc)), _size(0), _alloc(alloc)
+		{
+			try {
+				assign(first, last);
+			}
+			catch (...) {
+				_abandon();
+				throw;
+			}
+		}
+
+		segmented_vector	(segmented_vector const & other)
+			: _chunks(_new_index(other._alloc)), _size(0), _alloc(other._alloc)
+		{
+			try {
+				assign(other.begin(), other.end());
+			}
+			catch (...) {
+				_abandon();
+				throw;
+			}
+		}
+
+		segmented_vector &	operator = (segmented_vector const & other)
+		{
+			if (this != &other) {
+				assign(other.begin(), other.end());
+			}
+			return *this;
+		}
+
+		~segmented_vector()
+		{
+			_abandon();
+		}
+
+	// Member functions
+
+	// Capacity
+		size_type		size() const		{ return _size; }
+		size_type		capacity() const	{ return _chunks->size() * ChunkSize; }
+		size_type		max_size() const	{ return _alloc.max_size(); }
+		bool			empty() const		{ return _size == 0; }
+
+		void			resize(size_type n, value_type value = value_type())
+		{
+			while (_size > n) {
+				pop_back();
+			}
+			reserve(n);
+			while (_size < n) {
+				push_back(value);
+			}
+		}
+
+		void			reserve(size_type n)
+		{
+			if (n > max_size())
+				throw std::length_error("segmented_vector::reserve()::length_error");
+			while (capacity() < n) {
+				_add_chunk();
+			}
+		}
+
+		// Frees the chunks past the one holding the last element
+		void			shrink_to_fit()
+		{
+			_release_chunks((_size + ChunkSize - 1) / ChunkSize);
+		}
+
+	// Modifiers
+		template < class InputIterator >
+		void			assign(InputIterator first, InputIterator last,
+						typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			clear();
+			while (first != last) {
+				push_back(*first++);
+			}
+		}
+
+		void			assign(size_type n, value_type const & value)
+		{
+			clear();
+			reserve(n);
+			while (n) {
+				push_back(value);
+				n--;
+			}
+		}
+
+		void			push_back(value_type const & value)
+		{
+			if (_size == capacity()) {
+				_add_chunk();
+			}
+			_alloc.construct(&_at(_size), value);
+			_size++;
+		}
+
+		// Keeps one spare chunk so push/pop at a chunk boundary does not thrash
+		void			pop_back()
+		{
+			_size--;
+			_alloc.destroy(&_at(_size));
+			if (capacity() - _size > ChunkSize) {
+				_release_chunks(_chunks->size() - 1);
+			}
+		}
+
+		void			swap(segmented_vector & other)
+		{
+			std::swap(_chunks, other._chunks);
+			std::swap(_size, other._size);
+			std::swap(_alloc, other._alloc);
+		}
+
+		void			clear()
+		{
+			while (_size) {
+				_size--;
+				_alloc.destroy(&_at(_size));
+			}
+		}
+
+		allocator_type	get_allocator() const			{ return _alloc; }
+
+	// Element access
+		reference		front()							{ return _at(0); }
+		const_reference	front() const					{ return _at(0); }
+		reference		back()							{ return _at(_size - 1); }
+		const_reference	back() const					{ return _at(_size - 1); }
+		reference		operator [] (size_type n)		{ return _at(n); }
+		const_reference	operator [] (size_type n) const	{ return _at(n); }
+
+		reference		at (size_type n)
+		{
+			if (n >= size())
+				throw std::out_of_range("segmented_vector::at()::out_of_range");
+			return	_at(n);
+		}
+
+		const_reference	at (size_type n) const
+		{
+			if (n >= size())
+				throw std::out_of_range("segmented_vector::at()::out_of_range");
+			return	_at(n);
+		}
+
+	// Iterators
+		iterator				begin()			{ return iterator(_chunks, 0); }
+		const_iterator			begin() const	{ return const_iterator(_chunks, 0); }
+		iterator				end()			{ return iterator(_chunks, _size); }
+		const_iterator			end() const		{ return const_iterator(_chunks, _size); }
+		reverse_iterator		rbegin()		{ return reverse_iterator(end()); }
+		const_reverse_iterator	rbegin() const	{ return const_reverse_iterator(end()); }
+		reverse_iterator		rend()			{ return reverse_iterator(begin()); }
+		const_reverse_iterator	rend() const	{ return const_reverse_iterator(begin()); }
+
+	// Private member functions
+	private:
+		reference		_at(size_type n) const
+		{
+			return (*_chunks)[n / ChunkSize][n % ChunkSize];
+		}
+
+		void			_add_chunk()
+		{
+			pointer		chunk = _alloc.allocate(ChunkSize);
+
+			try {
+				_chunks->push_back(chunk);
+			}
+			catch (...) {
+				_alloc.deallocate(chunk, ChunkSize);
+				throw;
+			}
+		}
+
+		void			_release_chunks(size_type keep)
+		{
+			while (_chunks->size() > keep) {
+				_alloc.deallocate(_chunks->back(), ChunkSize);
+				_chunks->pop_back();
+			}
+		}
+
+		static chunk_index *	_new_index(allocator_type const & alloc)
+		{
+			chunk_index_allocator	a(alloc);
+			chunk_index *			index = a.allocate(1);
+
+			try {
+				a.construct(index, chunk_index(index_allocator(alloc)));
+			}
+			catch (...) {
+				a.deallocate(index, 1);
+				throw;
+			}
+			return index;
+		}
+
+		// Everything the destructor frees, also run by a constructor that throws
+		void			_abandon()
+		{
+			chunk_index_allocator	a(_alloc);
+
+			clear();
+			_release_chunks(0);
+			a.destroy(_chunks);
+			a.deallocate(_chunks, 1);
+		}
+
+	// Non-member overloads
+	public:
+		friend	bool	operator == (segmented_vector const & lhs, segmented_vector const & rhs) {
+			return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+		}
+		friend	bool	operator != (segmented_vector const & lhs, segmented_vector const & rhs) {
+			return !(lhs == rhs);
+		}
+		friend	bool	operator < (segmented_vector const & lhs, segmented_vector const & rhs) {
+			return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+		friend	bool	operator <= (segmented_vector const & lhs, segmented_vector const & rhs) {
+			return	!(rhs < lhs);
+		}
+		friend	bool	operator > (segmented_vector const & lhs, segmented_vector const & rhs) {
+			return rhs < lhs;
+		}
+		friend	bool	operator >= (segmented_vector const & lhs, segmented_vector const & rhs) {
+			return !(lhs < rhs);
+		}
+
+};
+
+	template < class T, size_t ChunkSize, class Alloc >
+	void	swap(segmented_vector<T, ChunkSize, Alloc> & lhs, segmented_vector<T, ChunkSize, Alloc> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
+
+
+#endif
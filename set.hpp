@@ -4,6 +4,7 @@
 # include <memory>
 
 # include "RBtree.hpp"
+# include "frozen_set.hpp"
 # include "utils.hpp"
 
 namespace	ft
@@ -43,6 +44,7 @@ class	set
 		typedef ft::reverse_iterator<iterator>				reverse_iterator;
 		typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
 		typedef typename tree_type::iterator				tree_iter;
+		typedef typename tree_type::template cursor<iterator>	cursor;
 
 	// Tree
 	private:
@@ -108,10 +110,33 @@ class	set
 		void			erase(iterator pos)						{ return _tree.erase((tree_iter &)pos); }
 		size_type		erase(key_type const & key)				{ return _tree.erase(key); }
 		void			erase(iterator first, iterator last)	{ return _tree.erase((tree_iter &)first, (tree_iter &)last); }
+		void			erase_below(key_type const & key)		{ _tree.erase_below(key); }
+		void			erase_above(key_type const & key)		{ _tree.erase_above(key); }
 		void			clear()									{ _tree.clear(); }
 
 		void			swap(set & s)							{ _tree.swap(s._tree); }
 
+		// Immutable copy with a pointer-free, cache friendly search layout
+		frozen_set<Key, Compare, Allocator>	freeze() const
+		{
+			return frozen_set<Key, Compare, Allocator>(begin(), end(), size(), key_comp(), get_allocator());
+		}
+
+		// Lookups and inserts through the cursor start from its last position
+		cursor			get_cursor()							{ return cursor(_tree); }
+
+		// Parallel building blocks of ft::bulk_load and ft::parallel_for_each,
+		// see parallel_map.hpp and RedBlackTree::assign_sorted_unique
+		template < class ForBlocks >
+		void			assign_sorted_unique(value_type const * const * values, size_type count,
+											 ForBlocks for_blocks)
+		{
+			_tree.assign_sorted_unique(values, count, for_blocks);
+		}
+
+		template < class ForBlocks, class Function >
+		void			parallel_for_each(ForBlocks for_blocks, Function f) const	{ _tree.parallel_for_each(for_blocks, f); }
+
 	// Observers
 		allocator_type	get_allocator() const					{ return _tree.get_allocator(); }
 		key_compare		key_comp() const						{ return _tree.key_comp(); }
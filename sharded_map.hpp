@@ -0,0 +1,328 @@
+#ifndef FT_SHARDED_MAP_HPP
+# define FT_SHARDED_MAP_HPP
+
+# include <new>
+# include <memory>
+
+# include <unistd.h>
+
+# include "atomic.hpp"
+# include "mutex.hpp"
+# include "map.hpp"
+# include "vector.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+// Map shared between writers: keys are hashed to one of a power of two of
+// independent ft::map shards, each behind its own reader-writer lock, so
+// updates to different shards never wait on each other. Lookups and updates
+// return copies or run a functor under the lock, never a reference that
+// would outlive it. Key order only exists across shards in for_each, which
+// merges them under all the shared locks at once
+template	<	class Key,
+				class T,
+				class Compare = less<Key>,
+				class Hash = hash<Key>,
+				class Allocator = std::allocator< pair<Key const, T> >
+			>
+class	sharded_map
+{
+	// Type definitions
+	public:
+		typedef Key											key_type;
+		typedef T											mapped_type;
+		typedef pair<key_type const, mapped_type>			value_type;
+		typedef Compare										key_compare;
+		typedef Hash										hasher;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::size_type			size_type;
+		typedef typename allocator_type::difference_type	difference_type;
+		typedef ft::map<Key, T, Compare, Allocator>			map_type;
+
+	// Private members
+	private:
+		// Padded so one shard's lock word and root never share a line with
+		// its neighbour's
+		struct	shard
+		{
+			mutable shared_mutex	lock;
+			map_type				map;
+			char					_pad[cache_line_size];
+
+			shard(key_compare const & comp, allocator_type const & alloc)
+				: map(comp, alloc)		{ }
+		};
+
+		typedef typename map_type::const_iterator		map_iterator;
+
+		struct	cursor
+		{
+			map_iterator	it;
+			map_iterator	end;
+		};
+
+		shard *			_shards;
+		size_type		_mask;
+		hasher			_hash;
+		key_compare		_comp;
+
+	// Constructors
+	public:
+		// shards is rounded up to a power of two; 0 picks four per online CPU
+		explicit sharded_map (size_type shards = 0,
+							  key_compare const & comp = key_compare(),
+							  hasher const & hash = hasher(),
+							  allocator_type const & alloc = allocator_type())
+			: _shards(NULL), _mask(0), _hash(hash), _comp(comp)
+		{
+			size_type	n = 1;
+			size_type	built = 0;
+
+			if (shards == 0) {
+				long const	cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+				shards = 4 * static_cast<size_type>(cpus > 0 ? cpus : 1);
+			}
+			while (n < shards) {
+				n <<= 1;
+			}
+			_shards = static_cast<shard *>(::operator new(n * sizeof(shard)));
+			try {
+				for (; built < n; built++) {
+					new (_shards + built) shard(comp, alloc);
+				}
+			}
+			catch (...) {
+				_destroy(built);
+				throw;
+			}
+			_mask = n - 1;
+		}
+
+		~sharded_map()
+		{
+			_destroy(_mask + 1);
+		}
+
+	// Capacity
+		// Sum of the shards as each is visited, not one point in time
+		size_type		size() const
+		{
+			size_type	n = 0;
+
+			for (size_type i = 0; i <= _mask; i++) {
+				shared_lock_guard<shared_mutex>	guard(_shards[i].lock);
+
+				n += _shards[i].map.size();
+			}
+			return n;
+		}
+
+		bool			empty() const		{ return size() == 0; }
+		size_type		shard_count() const	{ return _mask + 1; }
+
+	// Lookup
+		bool			find(key_type const & key, mapped_type & value) const
+		{
+			shard const &					s = _shard(key);
+			shared_lock_guard<shared_mutex>	guard(s.lock);
+			map_iterator					it = s.map.find(key);
+
+			if (it == s.map.end()) {
+				return false;
+			}
+			value = it->second;
+			return true;
+		}
+
+		size_type		count(key_type const & key) const
+		{
+			shard const &					s = _shard(key);
+			shared_lock_guard<shared_mutex>	guard(s.lock);
+
+			return s.map.count(key);
+		}
+
+	// Modifiers
+		// False, and the map unchanged, when the key is already there
+		bool			insert(value_type const & value)
+		{
+			shard &					s = _shard(value.first);
+			lock_guard<shared_mutex>	guard(s.lock);
+
+			return s.map.insert(value).second;
+		}
+
+		// True when the key was inserted, false when it was assigned
+		bool			insert_or_assign(key_type const & key, mapped_type const & obj)
+		{
+			shard &						s = _shard(key);
+			lock_guard<shared_mutex>	guard(s.lock);
+			pair<typename map_type::iterator, bool>	res = s.map.insert(value_type(key, obj));
+
+			if (!res.second) {
+				res.first->second = obj;
+			}
+			return res.second;
+		}
+
+		// Inserts a default value if key is absent; returns a copy
+		mapped_type		operator [] (key_type const & key)
+		{
+			shard &						s = _shard(key);
+			lock_guard<shared_mutex>	guard(s.lock);
+
+			return s.map[key];
+		}
+
+		// Calls f on the value of key, default inserted if absent, under the
+		// shard's exclusive lock: a read-modify-write such as a counter
+		// increment is atomic with respect to every other operation
+		template < class Function >
+		Function		update(key_type const & key, Function f)
+		{
+			shard &						s = _shard(key);
+			lock_guard<shared_mutex>	guard(s.lock);
+
+			f(s.map[key]);
+			return f;
+		}
+
+		size_type		erase(key_type const & key)
+		{
+			shard &						s = _shard(key);
+			lock_guard<shared_mutex>	guard(s.lock);
+
+			return s.map.erase(key);
+		}
+
+		void			clear()
+		{
+			for (size_type i = 0; i <= _mask; i++) {
+				lock_guard<shared_mutex>	guard(_shards[i].lock);
+
+				_shards[i].map.clear();
+			}
+		}
+
+	// Ordered view
+		// Calls f on every value in key order, a k-way merge of the shards
+		// under all their shared locks: a consistent view that holds back
+		// writers for its whole length. Locks are always taken in shard
+		// order, and writers only ever hold one, so this cannot deadlock
+		template < class Function >
+		Function		for_each(Function f) const
+		{
+			size_type	locked = 0;
+
+			try {
+				for (; locked <= _mask; locked++) {
+					_shards[locked].lock.lock_shared();
+				}
+				f = _merge(f);
+			}
+			catch (...) {
+				_unlock_shared(locked);
+				throw;
+			}
+			_unlock_shared(locked);
+			return f;
+		}
+
+	// Observers
+		key_compare		key_comp() const		{ return _comp; }
+		hasher			hash_function() const	{ return _hash; }
+
+	// Private member functions
+	private:
+		sharded_map (sharded_map const &);
+		sharded_map &	operator = (sharded_map const &);
+
+		shard &			_shard(key_type const & key)
+		{
+			return _shards[hash_mix(_hash(key)) & _mask];
+		}
+
+		shard const &	_shard(key_type const & key) const
+		{
+			return _shards[hash_mix(_hash(key)) & _mask];
+		}
+
+		void			_destroy(size_type n)
+		{
+			while (n) {
+				_shards[--n].~shard();
+			}
+			::operator delete(_shards);
+		}
+
+		void			_unlock_shared(size_type n) const
+		{
+			while (n) {
+				_shards[--n].lock.unlock_shared();
+			}
+		}
+
+		// Min-heap of the shards' next values
+		bool			_after(cursor const & a, cursor const & b) const
+		{
+			return _comp(b.it->first, a.it->first);
+		}
+
+		void			_sift_down(ft::vector<cursor> & heap, size_type i) const
+		{
+			size_type const	n = heap.size();
+			cursor const	c = heap[i];
+
+			for (size_type child = 2 * i + 1; child < n; child = 2 * i + 1) {
+				if (child + 1 < n && _after(heap[child], heap[child + 1])) {
+					child++;
+				}
+				if (!_after(c, heap[child])) {
+					break ;
+				}
+				heap[i] = heap[child];
+				i = child;
+			}
+			heap[i] = c;
+		}
+
+		template < class Function >
+		Function		_merge(Function f) const
+		{
+			ft::vector<cursor>	heap;
+
+			heap.reserve(_mask + 1);
+			for (size_type i = 0; i <= _mask; i++) {
+				cursor	c;
+
+				c.it = _shards[i].map.begin();
+				c.end = _shards[i].map.end();
+				if (c.it != c.end) {
+					heap.push_back(c);
+				}
+			}
+			for (size_type i = heap.size() / 2; i-- > 0; ) {
+				_sift_down(heap, i);
+			}
+			while (!heap.empty()) {
+				f(*heap[0].it);
+				if (++heap[0].it == heap[0].end) {
+					heap[0] = heap.back();
+					heap.pop_back();
+				}
+				if (!heap.empty()) {
+					_sift_down(heap, 0);
+				}
+			}
+			return f;
+		}
+
+};
+
+}
+
+#endif
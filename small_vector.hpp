@@ -0,0 +1,471 @@
+#ifndef FT_SMALL_VECTOR_HPP
+# define FT_SMALL_VECTOR_HPP
+
+# include <memory>
+# include <algorithm>
+# include <stdexcept>
+
+# include "iterator.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+// Vector keeping up to N elements inside the object itself;
+// the allocator is only used once the size grows beyond N
+template < class T, size_t N, class Allocator = std::allocator<T> >
+class	small_vector
+{
+	// Type definitions
+	public:
+		typedef T											value_type;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::size_type			size_type;
+		typedef typename allocator_type::difference_type	difference_type;
+		typedef typename allocator_type::reference			reference;
+		typedef typename allocator_type::const_reference	const_reference;
+		typedef typename allocator_type::pointer			pointer;
+		typedef typename allocator_type::const_pointer		const_pointer;
+		typedef ft::iterator<pointer>						iterator;
+		typedef ft::iterator<const_pointer>					const_iterator;
+		typedef ft::reverse_iterator<iterator>				reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+		static const size_type								inline_capacity = N;
+
+	// Private members
+	private:
+		pointer					_start;
+		pointer					_end;
+		pointer					_end_cap;
+		allocator_type			_alloc;
+		aligned_buffer<T, N>	_buffer;
+
+	// Constructors
+	public:
+		explicit small_vector	(allocator_type const & alloc = allocator_type())
+			: _alloc(alloc)
+		{
+			_reset_inline();
+		}
+
+		explicit small_vector	(size_type count, value_type const & value = value_type(),
+								 allocator_type const & alloc = allocator_type())
+			: _alloc(alloc)
+		{
+			_reset_inline();
+			try {
+				assign(count, value);
+			}
+			catch (...) {
+				_abandon();
+				throw;
+			}
+		}
+
+		template < class InputIterator >
+		small_vector	(InputIterator first, InputIterator last,
+						 allocator_type const & alloc = allocator_type(),
+						 typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+			: _alloc(alloc)
+		{
+			_reset_inline();
+			try {
+				while (first != last) {
+					push_back(*first++);
+				}
+			}
+			catch (...) {
+				_abandon();
+				throw;
+			}
+		}
+
+		small_vector	(small_vector const & other)
+			: _alloc(other.get_allocator())
+		{
+			_reset_inline();
+			try {
+				reserve(other.size());
+				_end = _construct_range(_start, other._start, other._end);
+			}
+			catch (...) {
+				_abandon();
+				throw;
+			}
+		}
+
+		small_vector &	operator = (small_vector const & other)
+		{
+			if (this != &other) {
+				clear();
+				reserve(other.size());
+				_end = _construct_range(_start, other._start, other._end);
+			}
+			return *this;
+		}
+
+		~small_vector()
+		{
+			clear();
+			_release_heap();
+		}
+
+	// Member functions
+
+	// Capacity
+		size_type		size() const		{ return static_cast<size_type>(_end - _start); }
+		size_type		capacity() const	{ return static_cast<size_type>(_end_cap - _start); }
+		size_type		max_size() const	{ return _alloc.max_size(); }
+		bool			empty() const		{ return _start == _end; }
+		bool			is_inline() const	{ return _start == _buffer.ptr(); }
+
+		void			resize(size_type n, value_type value = value_type())
+		{
+			if (n < size()) {
+				_destroy_after_pos(_start + n);
+			}
+			else if (n > capacity()) {
+				reserve(_recommend(n));
+			}
+			while (_end < _start + n) {
+				_alloc.construct(_end, value);
+				_end++;
+			}
+		}
+
+		void			reserve(size_type n)
+		{
+			if (n <= capacity())
+				return ;
+			if (n > max_size())
+				throw std::length_error("small_vector::reserve()::length_error");
+
+			pointer		new_ptr = _alloc.allocate(n);
+			size_type	_size = size();
+
+			try {
+				_construct_range(new_ptr, _start, _end);
+			}
+			catch (...) {
+				_alloc.deallocate(new_ptr, n);
+				throw;
+			}
+			clear();
+			_release_heap();
+			_start = new_ptr;
+			_end = _start + _size;
+			_end_cap = _start + n;
+		}
+
+		// Moves the elements back into the inline buffer when they fit
+		void			shrink_to_fit()
+		{
+			if (is_inline() || size() > N)
+				return ;
+
+			pointer		old_start = _start;
+			pointer		old_end = _end;
+			size_type	old_cap = capacity();
+
+			_end = _construct_range(_buffer.ptr(), old_start, old_end);
+			_start = _buffer.ptr();
+			_end_cap = _start + N;
+			for (pointer p = old_start; p != old_end; p++) {
+				_alloc.destroy(p);
+			}
+			_alloc.deallocate(old_start, old_cap);
+		}
+
+	// Modifiers
+		template < class InputIterator >
+		void			assign(InputIterator first, InputIterator last,
+						typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			clear();
+			while (first != last) {
+				push_back(*first++);
+			}
+		}
+
+		void			assign(size_type n, value_type const & value)
+		{
+			value_type	tmp(value);
+
+			clear();
+			if (n > capacity()) {
+				reserve(_recommend(n));
+			}
+			while (n) {
+				_alloc.construct(_end, tmp);
+				_end++;
+				n--;
+			}
+		}
+
+		void			push_back(value_type const & value)
+		{
+			if (_end != _end_cap) {
+				_alloc.construct(_end, value);
+			}
+			else {
+				value_type	tmp(value);
+
+				reserve(_recommend(size() + 1));
+				_alloc.construct(_end, tmp);
+			}
+			_end++;
+		}
+
+		void			pop_back()
+		{
+			_end--;
+			_alloc.destroy(_end);
+		}
+
+		iterator		insert(iterator pos, value_type const & value)
+		{
+			size_type	index = static_cast<size_type>(pos - begin());
+
+			insert(pos, 1, value);
+			return iterator(_start + index);
+		}
+
+		void			insert(iterator pos, size_type count, value_type const & value)
+		{
+			size_type	index = static_cast<size_type>(pos - begin());
+			value_type	tmp(value);
+
+			if (count == 0)
+				return ;
+			if (size() + count > capacity()) {
+				reserve(_recommend(size() + count));
+			}
+			_open_gap(_start + index, count, tmp);
+			std::fill(_start + index, _start + index + count, tmp);
+		}
+
+		template < class InputIterator >
+		void			insert(iterator pos, InputIterator first, InputIterator last,
+						typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			small_vector	tmp(first, last);
+			size_type		index = static_cast<size_type>(pos - begin());
+			size_type		count = tmp.size();
+
+			if (count == 0)
+				return ;
+			if (size() + count > capacity()) {
+				reserve(_recommend(size() + count));
+			}
+			_open_gap(_start + index, count, *tmp._start);
+			std::copy(tmp._start, tmp._end, _start + index);
+		}
+
+		iterator		erase(iterator pos)
+		{
+			return erase(pos, pos + 1);
+		}
+
+		iterator		erase(iterator first, iterator last)
+		{
+			pointer		new_end = std::copy(last.base(), _end, first.base());
+
+			_destroy_after_pos(new_end);
+			return first;
+		}
+
+		void			swap(small_vector & other)
+		{
+			if (!is_inline() && !other.is_inline()) {
+				std::swap(_start, other._start);
+				std::swap(_end, other._end);
+				std::swap(_end_cap, other._end_cap);
+			}
+			else if (is_inline() && other.is_inline()) {
+				small_vector &	longer = size() < other.size() ? other : *this;
+				small_vector &	shorter = size() < other.size() ? *this : other;
+				size_type		common = shorter.size();
+
+				std::swap_ranges(shorter._start, shorter._end, longer._start);
+				shorter._end = _construct_range(shorter._end, longer._start + common, longer._end);
+				longer._destroy_after_pos(longer._start + common);
+			}
+			else if (is_inline()) {
+				other._take_inline(*this);
+			}
+			else {
+				_take_inline(other);
+			}
+			std::swap(_alloc, other._alloc);
+		}
+
+		void			clear()							{ _destroy_after_pos(_start); }
+		allocator_type	get_allocator() const			{ return _alloc; }
+
+	// Element access
+		reference		front()							{ return *_start; }
+		const_reference	front() const					{ return *_start; }
+		reference		back()							{ return *(_end - 1); }
+		const_reference	back() const					{ return *(_end - 1); }
+		reference		operator [] (size_type n)		{ return _start[n]; }
+		const_reference	operator [] (size_type n) const	{ return _start[n]; }
+
+		reference		at (size_type n)
+		{
+			if (n >= size())
+				throw std::out_of_range("small_vector::at()::out_of_range");
+			return	_start[n];
+		}
+
+		const_reference	at (size_type n) const
+		{
+			if (n >= size())
+				throw std::out_of_range("small_vector::at()::out_of_range");
+			return	_start[n];
+		}
+
+	// Iterators
+		iterator				begin()			{ return iterator(_start); }
+		const_iterator			begin() const	{ return iterator(_start); }
+		iterator				end()			{ return iterator(_end); }
+		const_iterator			end() const		{ return iterator(_end); }
+		reverse_iterator		rbegin()		{ return reverse_iterator(_end); }
+		const_reverse_iterator	rbegin() const	{ return reverse_iterator(_end); }
+		reverse_iterator		rend()			{ return reverse_iterator(_start); }
+		const_reverse_iterator	rend() const	{ return reverse_iterator(_start); }
+
+	// Private member functions
+	private:
+		void			_reset_inline()
+		{
+			_start = _buffer.ptr();
+			_end = _start;
+			_end_cap = _start + N;
+		}
+
+		void			_release_heap()
+		{
+			if (!is_inline()) {
+				_alloc.deallocate(_start, capacity());
+				_reset_inline();
+			}
+		}
+
+		// A constructor that throws never gets its destructor called:
+		// what it built and the heap block it took are freed here
+		void			_abandon()
+		{
+			clear();
+			_release_heap();
+		}
+
+		// Copy-constructs [first, last) into raw memory at dest,
+		// destroying what was built so far if a copy throws
+		pointer			_construct_range(pointer dest, const_pointer first, const_pointer last)
+		{
+			pointer		cur = dest;
+
+			try {
+				for (; first != last; first++, cur++) {
+					_alloc.construct(cur, *first);
+				}
+			}
+			catch (...) {
+				while (cur != dest)
+					_alloc.destroy(--cur);
+				throw;
+			}
+			return cur;
+		}
+
+		void			_destroy_after_pos(pointer pos)
+		{
+			while (pos != _end)
+				_alloc.destroy(--_end);
+		}
+
+		// Shifts [pos, _end) right by count, capacity must already suffice;
+		// [pos, pos + count) is left holding constructed objects to be assigned
+		void			_open_gap(pointer pos, size_type count, const_reference filler)
+		{
+			pointer		old_end = _end;
+			size_type	after = static_cast<size_type>(_end - pos);
+
+			if (after > count) {
+				_end = _construct_range(_end, _end - count, _end);
+				std::copy_backward(pos, old_end - count, old_end);
+			}
+			else {
+				while (_end != pos + count) {
+					_alloc.construct(_end, filler);
+					_end++;
+				}
+				_end = _construct_range(_end, pos, old_end);
+			}
+		}
+
+		// this is on the heap, small is inline: this gets small's elements
+		// in its own buffer and hands its heap block over to small
+		void			_take_inline(small_vector & small)
+		{
+			pointer		heap_start = _start;
+			pointer		heap_end = _end;
+			pointer		heap_cap = _end_cap;
+
+			_reset_inline();
+			_end = _construct_range(_start, small._start, small._end);
+			small.clear();
+			small._start = heap_start;
+			small._end = heap_end;
+			small._end_cap = heap_cap;
+		}
+
+		size_type		_recommend(size_type new_size) const
+		{
+			size_type const		max_sz = max_size();
+			size_type const		cap = capacity();
+
+			if (new_size > max_sz) {
+				throw std::length_error("small_vector::reserve()::length_error");
+			}
+			if (cap >= max_sz / 2) {
+				return max_sz;
+			}
+			return std::max<size_type>(2 * cap, new_size);
+		}
+
+	// Non-member overloads
+	public:
+		friend	bool	operator == (small_vector const & lhs, small_vector const & rhs) {
+			return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+		}
+		friend	bool	operator != (small_vector const & lhs, small_vector const & rhs) {
+			return !(lhs == rhs);
+		}
+		friend	bool	operator < (small_vector const & lhs, small_vector const & rhs) {
+			return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+		friend	bool	operator <= (small_vector const & lhs, small_vector const & rhs) {
+			return	!(rhs < lhs);
+		}
+		friend	bool	operator > (small_vector const & lhs, small_vector const & rhs) {
+			return rhs < lhs;
+		}
+		friend	bool	operator >= (small_vector const & lhs, small_vector const & rhs) {
+			return !(lhs < rhs);
+		}
+
+};
+
+	template < class T, size_t N, class Alloc >
+	void	swap(small_vector<T, N, Alloc> & lhs, small_vector<T, N, Alloc> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
+
+
+#endif
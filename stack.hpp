@@ -22,6 +22,7 @@ class	stack
 
 	public:
 		explicit stack(const container_type & cont = container_type()) : c(cont) { }
+		stack(stack const & other) : c(other.c) { }
 
 		stack &		operator = (stack const & other)  { c = other.c; return *this; }
 
@@ -0,0 +1,334 @@
+#ifndef FT_STATIC_VECTOR_HPP
+# define FT_STATIC_VECTOR_HPP
+
+# include <new>
+# include <algorithm>
+# include <stdexcept>
+
+# include "iterator.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+// Vector with a compile-time capacity of N elements stored inside the object;
+// it never allocates, growing past N throws std::length_error
+template < class T, size_t N >
+class	static_vector
+{
+	// Type definitions
+	public:
+		typedef T											value_type;
+		typedef size_t										size_type;
+		typedef ptrdiff_t									difference_type;
+		typedef value_type &								reference;
+		typedef value_type const &							const_reference;
+		typedef value_type *								pointer;
+		typedef value_type const *							const_pointer;
+		typedef ft::iterator<pointer>						iterator;
+		typedef ft::iterator<const_pointer>					const_iterator;
+		typedef ft::reverse_iterator<iterator>				reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+	// Private members
+	private:
+		size_type				_size;
+		aligned_buffer<T, N>	_buffer;
+
+	// Constructors
+	public:
+		static_vector	() : _size(0)							{ }
+
+		explicit static_vector	(size_type count, value_type const & value = value_type())
+			: _size(0)
+		{
+			try {
+				assign(count, value);
+			}
+			catch (...) {
+				clear();
+				throw;
+			}
+		}
+
+		template < class InputIterator >
+		static_vector	(InputIterator first, InputIterator last,
+						 typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+			: _size(0)
+		{
+			try {
+				while (first != last) {
+					push_back(*first++);
+				}
+			}
+			catch (...) {
+				clear();
+				throw;
+			}
+		}
+
+		static_vector	(static_vector const & other) : _size(0)
+		{
+			try {
+				_construct_range(other._start(), other._end());
+			}
+			catch (...) {
+				clear();
+				throw;
+			}
+		}
+
+		static_vector &	operator = (static_vector const & other)
+		{
+			if (this != &other) {
+				clear();
+				_construct_range(other._start(), other._end());
+			}
+			return *this;
+		}
+
+		~static_vector()
+		{
+			clear();
+		}
+
+	// Member functions
+
+	// Capacity
+		size_type		size() const		{ return _size; }
+		size_type		capacity() const	{ return N; }
+		size_type		max_size() const	{ return N; }
+		bool			empty() const		{ return _size == 0; }
+		bool			full() const		{ return _size == N; }
+
+		void			resize(size_type n, value_type value = value_type())
+		{
+			_check_capacity(n, "static_vector::resize()::length_error");
+			if (n < _size) {
+				_destroy_after_pos(_start() + n);
+			}
+			while (_size < n) {
+				_construct(_end(), value);
+			}
+		}
+
+		void			reserve(size_type n)
+		{
+			_check_capacity(n, "static_vector::reserve()::length_error");
+		}
+
+	// Modifiers
+		template < class InputIterator >
+		void			assign(InputIterator first, InputIterator last,
+						typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			clear();
+			while (first != last) {
+				push_back(*first++);
+			}
+		}
+
+		void			assign(size_type n, value_type const & value)
+		{
+			value_type	tmp(value);
+
+			_check_capacity(n, "static_vector::assign()::length_error");
+			clear();
+			while (n) {
+				_construct(_end(), tmp);
+				n--;
+			}
+		}
+
+		void			push_back(value_type const & value)
+		{
+			_check_capacity(_size + 1, "static_vector::push_back()::length_error");
+			_construct(_end(), value);
+		}
+
+		void			pop_back()
+		{
+			_size--;
+			_end()->~value_type();
+		}
+
+		iterator		insert(iterator pos, value_type const & value)
+		{
+			size_type	index = static_cast<size_type>(pos - begin());
+
+			insert(pos, 1, value);
+			return iterator(_start() + index);
+		}
+
+		void			insert(iterator pos, size_type count, value_type const & value)
+		{
+			value_type	tmp(value);
+
+			if (count == 0)
+				return ;
+			_check_capacity(_size + count, "static_vector::insert()::length_error");
+			_open_gap(pos.base(), count, tmp);
+			std::fill(pos.base(), pos.base() + count, tmp);
+		}
+
+		template < class InputIterator >
+		void			insert(iterator pos, InputIterator first, InputIterator last,
+						typename enable_if<!is_integral<InputIterator>::value>::type * = 0)
+		{
+			static_vector	tmp(first, last);
+
+			if (tmp.empty())
+				return ;
+			_check_capacity(_size + tmp.size(), "static_vector::insert()::length_error");
+			_open_gap(pos.base(), tmp.size(), tmp.front());
+			std::copy(tmp.begin().base(), tmp.end().base(), pos.base());
+		}
+
+		iterator		erase(iterator pos)
+		{
+			return erase(pos, pos + 1);
+		}
+
+		iterator		erase(iterator first, iterator last)
+		{
+			pointer		new_end = std::copy(last.base(), _end(), first.base());
+
+			_destroy_after_pos(new_end);
+			return first;
+		}
+
+		void			swap(static_vector & other)
+		{
+			static_vector &	longer = _size < other._size ? other : *this;
+			static_vector &	shorter = _size < other._size ? *this : other;
+			size_type		common = shorter._size;
+
+			std::swap_ranges(shorter._start(), shorter._end(), longer._start());
+			shorter._construct_range(longer._start() + common, longer._end());
+			longer._destroy_after_pos(longer._start() + common);
+		}
+
+		void			clear()							{ _destroy_after_pos(_start()); }
+
+	// Element access
+		reference		front()							{ return *_start(); }
+		const_reference	front() const					{ return *_start(); }
+		reference		back()							{ return *(_end() - 1); }
+		const_reference	back() const					{ return *(_end() - 1); }
+		reference		operator [] (size_type n)		{ return _start()[n]; }
+		const_reference	operator [] (size_type n) const	{ return _start()[n]; }
+
+		reference		at (size_type n)
+		{
+			if (n >= size())
+				throw std::out_of_range("static_vector::at()::out_of_range");
+			return	_start()[n];
+		}
+
+		const_reference	at (size_type n) const
+		{
+			if (n >= size())
+				throw std::out_of_range("static_vector::at()::out_of_range");
+			return	_start()[n];
+		}
+
+		pointer			data()							{ return _start(); }
+		const_pointer	data() const					{ return _start(); }
+
+	// Iterators
+		iterator				begin()			{ return iterator(_start()); }
+		const_iterator			begin() const	{ return const_iterator(_start()); }
+		iterator				end()			{ return iterator(_end()); }
+		const_iterator			end() const		{ return const_iterator(_end()); }
+		reverse_iterator		rbegin()		{ return reverse_iterator(end()); }
+		const_reverse_iterator	rbegin() const	{ return const_reverse_iterator(end()); }
+		reverse_iterator		rend()			{ return reverse_iterator(begin()); }
+		const_reverse_iterator	rend() const	{ return const_reverse_iterator(begin()); }
+
+	// Private member functions
+	private:
+		pointer			_start()						{ return _buffer.ptr(); }
+		const_pointer	_start() const					{ return _buffer.ptr(); }
+		pointer			_end()							{ return _buffer.ptr() + _size; }
+		const_pointer	_end() const					{ return _buffer.ptr() + _size; }
+
+		static void		_check_capacity(size_type n, char const * what)
+		{
+			if (n > N)
+				throw std::length_error(what);
+		}
+
+		// Placement-constructs at p == _end() and accounts for it
+		void			_construct(pointer p, const_reference value)
+		{
+			new (static_cast<void *>(p)) value_type(value);
+			_size++;
+		}
+
+		void			_construct_range(const_pointer first, const_pointer last)
+		{
+			for (; first != last; first++) {
+				_construct(_end(), *first);
+			}
+		}
+
+		void			_destroy_after_pos(pointer pos)
+		{
+			while (pos != _end()) {
+				_size--;
+				_end()->~value_type();
+			}
+		}
+
+		// Shifts [pos, end) right by count, capacity was checked by the caller;
+		// [pos, pos + count) is left holding constructed objects to be assigned
+		void			_open_gap(pointer pos, size_type count, const_reference filler)
+		{
+			pointer		old_end = _end();
+
+			if (static_cast<size_type>(old_end - pos) > count) {
+				_construct_range(old_end - count, old_end);
+				std::copy_backward(pos, old_end - count, old_end);
+			}
+			else {
+				while (_end() != pos + count) {
+					_construct(_end(), filler);
+				}
+				_construct_range(pos, old_end);
+			}
+		}
+
+	// Non-member overloads
+	public:
+		friend	bool	operator == (static_vector const & lhs, static_vector const & rhs) {
+			return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+		}
+		friend	bool	operator != (static_vector const & lhs, static_vector const & rhs) {
+			return !(lhs == rhs);
+		}
+		friend	bool	operator < (static_vector const & lhs, static_vector const & rhs) {
+			return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+		friend	bool	operator <= (static_vector const & lhs, static_vector const & rhs) {
+			return	!(rhs < lhs);
+		}
+		friend	bool	operator > (static_vector const & lhs, static_vector const & rhs) {
+			return rhs < lhs;
+		}
+		friend	bool	operator >= (static_vector const & lhs, static_vector const & rhs) {
+			return !(lhs < rhs);
+		}
+
+};
+
+	template < class T, size_t N >
+	void	swap(static_vector<T, N> & lhs, static_vector<T, N> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}
+
+
+#endif
@@ -0,0 +1,908 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include <cstdlib>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "colors.h"
+#include "atomic.hpp"
+#include "mutex.hpp"
+#include "vector.hpp"
+#include "map.hpp"
+#include "concurrent_map.hpp"
+#include "sharded_map.hpp"
+#include "stack.hpp"
+#include "concurrent_stack.hpp"
+#include "ring.hpp"
+#include "work_stealing_deque.hpp"
+#include "thread_pool.hpp"
+#include "parallel_map.hpp"
+
+// Multi-threaded stress test and throughput benchmark of the concurrent
+// containers: every benchmark runs its workload on 1, 2, 4... threads up to
+// the online CPUs, checks that nothing was lost or duplicated and prints
+// millions of operations per second.
+//
+//	./stress [operations per thread] [maximum threads]
+
+struct	Bench
+{
+	virtual ~Bench()							{ }
+	virtual void	reset(size_t threads)		{ (void)threads; }
+	virtual void	run(size_t thread, size_t ops) = 0;
+	virtual size_t	total(size_t threads, size_t ops)	{ return threads * ops; }
+	virtual bool	check() = 0;
+};
+
+struct	Context
+{
+	Bench *				bench;
+	pthread_barrier_t *	start;
+	size_t				thread;
+	size_t				ops;
+};
+
+static void *	worker(void * arg)
+{
+	Context *	ctx = static_cast<Context *>(arg);
+
+	pthread_barrier_wait(ctx->start);
+	ctx->bench->run(ctx->thread, ctx->ops);
+	return NULL;
+}
+
+static double	now()
+{
+	struct timeval	tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static bool		run(std::string const & name, Bench & bench, size_t max_threads, size_t ops)
+{
+	bool	ok = true;
+
+	std::cout << CYAN << name << RESET << std::endl;
+	for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+		pthread_barrier_t	start;
+		pthread_t *			tids = new pthread_t[threads];
+		Context *			ctx = new Context[threads];
+		double				t;
+
+		bench.reset(threads);
+		pthread_barrier_init(&start, NULL, threads + 1);
+		for (size_t i = 0; i < threads; i++) {
+			ctx[i].bench = &bench;
+			ctx[i].start = &start;
+			ctx[i].thread = i;
+			ctx[i].ops = ops;
+			pthread_create(&tids[i], NULL, worker, &ctx[i]);
+		}
+		pthread_barrier_wait(&start);
+		t = now();
+		for (size_t i = 0; i < threads; i++) {
+			pthread_join(tids[i], NULL);
+		}
+		t = now() - t;
+		pthread_barrier_destroy(&start);
+		delete [] tids;
+		delete [] ctx;
+
+		bool const	passed = bench.check();
+
+		ok = ok && passed;
+		std::cout	<< "  " << std::setw(3) << threads << " threads  "
+					<< std::setw(9) << std::fixed << std::setprecision(2)
+					<< bench.total(threads, ops) / t / 1e6 << " Mops/s  "
+					<< (passed ? GREEN "ok" : RED "LOST OR DUPLICATED") << RESET << std::endl;
+	}
+	return ok;
+}
+
+// Stacks
+// Every thread alternates pushes of its own distinct values and pops;
+// the sums pushed and popped, plus what is left, must match
+
+struct	StackBench : public Bench
+{
+	long		pushed;
+	long		popped;
+
+	void			reset(size_t)	{ pushed = 0; popped = 0; }
+
+	void			account(long in, long out)
+	{
+		ft::atomic_fetch_add(&pushed, in);
+		ft::atomic_fetch_add(&popped, out);
+	}
+};
+
+struct	LockedStack : public StackBench
+{
+	ft::mutex			lock;
+	ft::stack<long>		stack;
+
+	void	run(size_t thread, size_t ops)
+	{
+		long	in = 0;
+		long	out = 0;
+
+		for (size_t i = 0; i < ops; i++) {
+			long const	v = static_cast<long>(thread * ops + i + 1);
+
+			if (i % 2 == 0) {
+				ft::lock_guard<ft::mutex>	guard(lock);
+
+				stack.push(v);
+				in += v;
+			}
+			else {
+				ft::lock_guard<ft::mutex>	guard(lock);
+
+				if (!stack.empty()) {
+					out += stack.top();
+					stack.pop();
+				}
+			}
+		}
+		account(in, out);
+	}
+
+	bool	check()
+	{
+		while (!stack.empty()) {
+			popped += stack.top();
+			stack.pop();
+		}
+		return pushed == popped;
+	}
+};
+
+struct	LockFreeStack : public StackBench
+{
+	ft::concurrent_stack<long>	stack;
+
+	void	run(size_t thread, size_t ops)
+	{
+		long	in = 0;
+		long	out = 0;
+		long	v;
+
+		for (size_t i = 0; i < ops; i++) {
+			v = static_cast<long>(thread * ops + i + 1);
+			if (i % 2 == 0) {
+				stack.push(v);
+				in += v;
+			}
+			else if (stack.try_pop(v)) {
+				out += v;
+			}
+		}
+		account(in, out);
+	}
+
+	bool	check()
+	{
+		long	v;
+
+		while (stack.try_pop(v)) {
+			popped += v;
+		}
+		return pushed == popped;
+	}
+};
+
+struct	BatchedStack : public StackBench
+{
+	static const size_t			batch = 16;
+	ft::concurrent_stack<long>	stack;
+
+	void	run(size_t thread, size_t ops)
+	{
+		long	in = 0;
+		long	out = 0;
+		long	values[batch];
+
+		for (size_t i = 0; i + batch <= ops; i += batch) {
+			if (i / batch % 2 == 0) {
+				for (size_t j = 0; j < batch; j++) {
+					values[j] = static_cast<long>(thread * ops + i + j + 1);
+					in += values[j];
+				}
+				stack.push_batch(values, values + batch);
+			}
+			else {
+				size_t const	n = stack.pop_batch(values, batch);
+
+				for (size_t j = 0; j < n; j++) {
+					out += values[j];
+				}
+			}
+		}
+		account(in, out);
+	}
+
+	bool	check()
+	{
+		long	v;
+
+		while (stack.try_pop(v)) {
+			popped += v;
+		}
+		return pushed == popped;
+	}
+};
+
+// Rings
+// One thread alone alternates pushes and pops; otherwise the first half
+// of the threads produce ops values each and the rest consume them all.
+// The single producer rings are run as independent pairs of threads
+
+struct	SpscRing : public StackBench
+{
+	static const size_t				capacity = 1024;
+	ft::vector<ft::spsc_ring<long> *>	rings;
+	size_t							threads;
+
+	~SpscRing()			{ clear(); }
+
+	void	clear()
+	{
+		for (size_t i = 0; i < rings.size(); i++) {
+			delete rings[i];
+		}
+		rings.clear();
+	}
+
+	void	reset(size_t n)
+	{
+		StackBench::reset(n);
+		clear();
+		threads = n;
+		for (size_t i = 0; i < (n + 1) / 2; i++) {
+			rings.push_back(new ft::spsc_ring<long>(capacity));
+		}
+	}
+
+	void	run(size_t thread, size_t ops)
+	{
+		ft::spsc_ring<long> &	ring = *rings[thread / 2];
+		long					in = 0;
+		long					out = 0;
+		long					v;
+
+		if (threads == 1) {
+			for (size_t i = 0; i < ops; i++) {
+				v = static_cast<long>(i + 1);
+				if (i % 2 == 0) {
+					ring.push(v);
+					in += v;
+				}
+				else if (ring.try_pop(v)) {
+					out += v;
+				}
+			}
+		}
+		else if (thread + 1 == threads && threads % 2) {
+			return ;
+		}
+		else if (thread % 2 == 0) {
+			for (size_t i = 0; i < ops; i++) {
+				v = static_cast<long>(thread * ops + i + 1);
+				while (!ring.try_push(v)) {
+					sched_yield();
+				}
+				in += v;
+			}
+		}
+		else {
+			for (size_t i = 0; i < ops; i++) {
+				while (!ring.try_pop(v)) {
+					sched_yield();
+				}
+				out += v;
+			}
+		}
+		account(in, out);
+	}
+
+	bool	check()
+	{
+		long	v;
+
+		for (size_t i = 0; i < rings.size(); i++) {
+			while (rings[i]->try_pop(v)) {
+				popped += v;
+			}
+		}
+		return pushed == popped;
+	}
+};
+
+struct	MpmcRing : public StackBench
+{
+	ft::mpmc_ring<long>		ring;
+	size_t					threads;
+	size_t					consumed;
+
+	MpmcRing() : ring(1024)	{ }
+
+	void	reset(size_t n)
+	{
+		StackBench::reset(n);
+		threads = n;
+		consumed = 0;
+	}
+
+	void	run(size_t thread, size_t ops)
+	{
+		size_t const	producers = threads / 2;
+		long			in = 0;
+		long			out = 0;
+		long			v;
+
+		if (threads == 1) {
+			for (size_t i = 0; i < ops; i++) {
+				v = static_cast<long>(i + 1);
+				if (i % 2 == 0) {
+					ring.push(v);
+					in += v;
+				}
+				else if (ring.try_pop(v)) {
+					out += v;
+				}
+			}
+		}
+		else if (thread < producers) {
+			for (size_t i = 0; i < ops; i++) {
+				v = static_cast<long>(thread * ops + i + 1);
+				while (!ring.try_push(v)) {
+					sched_yield();
+				}
+				in += v;
+			}
+		}
+		else {
+			while (ft::atomic_load(&consumed, ft::memory_order_relaxed) < producers * ops) {
+				if (ring.try_pop(v)) {
+					out += v;
+					ft::atomic_fetch_add(&consumed, size_t(1), ft::memory_order_relaxed);
+				}
+				else {
+					sched_yield();
+				}
+			}
+		}
+		account(in, out);
+	}
+
+	bool	check()
+	{
+		long	v;
+
+		while (ring.try_pop(v)) {
+			popped += v;
+		}
+		return pushed == popped;
+	}
+};
+
+// Work stealing
+// The first thread owns the deque, pushing every value and popping every
+// other time, the rest steal until the owner is done and the deque empty
+
+struct	StealingDeque : public StackBench
+{
+	ft::work_stealing_deque<long>	deque;
+	bool							done;
+
+	void	reset(size_t n)
+	{
+		StackBench::reset(n);
+		done = false;
+	}
+
+	void	run(size_t thread, size_t ops)
+	{
+		long	in = 0;
+		long	out = 0;
+		long	v;
+
+		if (thread == 0) {
+			for (size_t i = 0; i < ops; i++) {
+				v = static_cast<long>(i + 1);
+				deque.push(v);
+				in += v;
+				if (i % 2 && deque.pop(v)) {
+					out += v;
+				}
+			}
+			while (deque.pop(v)) {
+				out += v;
+			}
+			ft::atomic_store(&done, true);
+		}
+		else {
+			while (!ft::atomic_load(&done) || !deque.empty()) {
+				if (deque.steal(v)) {
+					out += v;
+				}
+				else {
+					sched_yield();
+				}
+			}
+		}
+		account(in, out);
+	}
+
+	size_t	total(size_t, size_t ops)	{ return ops; }
+
+	bool	check()
+	{
+		return pushed == popped;
+	}
+};
+
+// Fork/join sum of a hash of 1..ops on a pool of as many workers as
+// threads: every task splits its range in two, forks one half and recurses
+// on the other
+
+struct	ForkJoinSum : public Bench
+{
+	static const size_t		grain = 256;
+	ft::thread_pool *		pool;
+	size_t					ops;
+	long					sum;
+
+	struct	Range
+	{
+		ForkJoinSum *	bench;
+		size_t			first;
+		size_t			last;
+
+		void	operator () () const
+		{
+			ft::thread_pool::task_group	children;
+			size_t						lo = first;
+			size_t						hi = last;
+
+			while (hi - lo > grain) {
+				Range	half = { bench, lo + (hi - lo) / 2, hi };
+
+				bench->pool->submit(children, half);
+				hi = half.first;
+			}
+
+			long	s = 0;
+
+			for (size_t i = lo; i < hi; i++) {
+				s += static_cast<long>(ft::hash_mix(i) >> 16);
+			}
+			ft::atomic_fetch_add(&bench->sum, s);
+			bench->pool->wait(children);
+		}
+	};
+
+	ForkJoinSum() : pool(NULL)		{ }
+	~ForkJoinSum()					{ delete pool; }
+
+	void	reset(size_t threads)
+	{
+		delete pool;
+		pool = NULL;
+		pool = new ft::thread_pool(threads);
+		sum = 0;
+	}
+
+	void	run(size_t thread, size_t ops)
+	{
+		Range	all = { this, 1, ops + 1 };
+
+		if (thread == 0) {
+			this->ops = ops;
+			pool->submit(all);
+			pool->wait();
+		}
+	}
+
+	size_t	total(size_t, size_t ops)	{ return ops; }
+
+	bool	check()
+	{
+		long	expected = 0;
+
+		for (size_t i = 1; i <= total(1, ops); i++) {
+			expected += static_cast<long>(ft::hash_mix(i) >> 16);
+		}
+		return sum == expected;
+	}
+};
+
+// Parallel fill, copy and compare of one vector of ops elements
+struct	ParallelVector : public Bench
+{
+	ft::thread_pool *		pool;
+	bool					same;
+
+	ParallelVector() : pool(NULL), same(false)		{ }
+	~ParallelVector()								{ delete pool; }
+
+	void	reset(size_t threads)
+	{
+		delete pool;
+		pool = NULL;
+		pool = new ft::thread_pool(threads);
+		same = false;
+	}
+
+	void	run(size_t thread, size_t ops)
+	{
+		if (thread == 0) {
+			ft::vector<long>	filled;
+			ft::vector<long>	copied;
+
+			ft::parallel_fill(*pool, filled, ops, 42L);
+			ft::parallel_copy(*pool, copied, filled);
+			same = ft::parallel_equal(*pool, filled, copied) && copied.size() == ops;
+		}
+	}
+
+	size_t	total(size_t, size_t ops)	{ return ops; }
+
+	bool	check()		{ return same; }
+};
+
+// Parallel bulk load of ops shuffled keys, then a parallel sum over them
+struct	ParallelMapLoad : public Bench
+{
+	ft::thread_pool *		pool;
+	size_t					ops;
+	long					sum;
+
+	struct	Sum
+	{
+		long *	sum;
+
+		void	operator () (ft::pair<long const, long> const & value)
+		{
+			ft::atomic_fetch_add(sum, value.second);
+		}
+	};
+
+	ParallelMapLoad() : pool(NULL)		{ }
+	~ParallelMapLoad()					{ delete pool; }
+
+	void	reset(size_t threads)
+	{
+		delete pool;
+		pool = NULL;
+		pool = new ft::thread_pool(threads);
+		sum = 0;
+	}
+
+	void	run(size_t thread, size_t ops)
+	{
+		if (thread == 0) {
+			ft::vector< ft::pair<long, long> >	input;
+			ft::map<long, long>					map;
+			Sum									f = { &sum };
+
+			this->ops = ops;
+			input.reserve(ops);
+			for (size_t i = 0; i < ops; i++) {
+				input.push_back(ft::make_pair(static_cast<long>(ft::hash_mix(i)), 1L));
+			}
+			ft::bulk_load(*pool, map, input.begin(), input.end());
+			ft::parallel_for_each(*pool, map, f);
+		}
+	}
+
+	size_t	total(size_t, size_t ops)	{ return ops; }
+
+	bool	check()		{ return sum == static_cast<long>(ops); }
+};
+
+// Concurrent map
+// The even threads write their own keys, inserting each one and erasing
+// every other, then assigning a new value to the one they kept; the odd
+// threads walk snapshots until the writers are done, each walk has to be
+// in key order and see only values some writer stored
+
+struct	ConcurrentMap : public Bench
+{
+	ft::concurrent_map<long, long>	map;
+	size_t							threads;
+	size_t							writers;
+	size_t							finished;
+	size_t							ops;
+	bool							walks_ok;
+
+	struct	Walk
+	{
+		long	last;
+		size_t	count;
+		bool	ok;
+
+		void	operator () (ft::pair<long const, long> const & value)
+		{
+			if ((count && value.first <= last)
+				|| (value.second != value.first && value.second != 2 * value.first)) {
+				ok = false;
+			}
+			last = value.first;
+			count++;
+		}
+	};
+
+	static long		key(size_t writer, size_t ops, size_t i)
+	{
+		return static_cast<long>(writer * ops + i + 1);
+	}
+
+	static Walk		walk(ft::concurrent_map<long, long> const & map)
+	{
+		ft::concurrent_map<long, long>::snapshot	s(map);
+		Walk										w = { 0, 0, true };
+
+		return s.for_each(w);
+	}
+
+	void	reset(size_t n)
+	{
+		map.clear();
+		threads = n;
+		writers = n == 1 ? 1 : (n + 1) / 2;
+		finished = 0;
+		walks_ok = true;
+	}
+
+	void	run(size_t thread, size_t ops)
+	{
+		if (thread % 2 == 0 || threads == 1) {
+			size_t const	writer = thread / 2;
+
+			if (thread == 0) {
+				this->ops = ops;
+			}
+			for (size_t i = 0; i < ops; i++) {
+				long const	k = key(writer, ops, i);
+
+				map.insert(ft::make_pair(k, k));
+				if (i % 2) {
+					map.erase(k - 1);
+					map.insert_or_assign(k, 2 * k);
+				}
+			}
+			ft::atomic_fetch_add(&finished, size_t(1));
+		}
+		else {
+			do {
+				if (!walk(map).ok) {
+					ft::atomic_store(&walks_ok, false);
+				}
+			} while (ft::atomic_load(&finished) < writers);
+		}
+	}
+
+	size_t	total(size_t, size_t ops)	{ return writers * ops; }
+
+	// Every writer kept exactly its odd indices, with their assigned value
+	bool	check()
+	{
+		Walk const	w = walk(map);
+		long		value;
+
+		if (!walks_ok || !w.ok || w.count != writers * (ops / 2) || map.size() != w.count) {
+			return false;
+		}
+		for (size_t writer = 0; writer < writers; writer++) {
+			for (size_t i = 0; i < ops; i++) {
+				long const	k = key(writer, ops, i);
+				bool const	found = map.find(k, value);
+
+				if (found != (i % 2 == 1) || (found && value != 2 * k)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+};
+
+// Sharded map
+// The even threads bump counters every writer shares through update(), and
+// insert and erase keys of their own as above; the odd threads walk the map
+// with for_each until the writers are done. No increment may be lost and
+// every walk has to be in key order across the shards. A walk holds every
+// shard's shared lock and the rwlock favours readers, so walks only start
+// again once the writers made progress, or they could starve the writers
+
+struct	ShardedMap : public Bench
+{
+	static const long				counters = 64;
+	ft::sharded_map<long, long>		map;
+	size_t							threads;
+	size_t							writers;
+	size_t							finished;
+	size_t							progress;
+	size_t							ops;
+	bool							walks_ok;
+
+	struct	Increment
+	{
+		void	operator () (long & value)		{ value++; }
+	};
+
+	// Counters have the keys -counters to -1, under every writer's keys
+	struct	Walk
+	{
+		long	last;
+		size_t	count;
+		long	sum;
+		bool	ok;
+
+		void	operator () (ft::pair<long const, long> const & value)
+		{
+			if ((count && value.first <= last) || (value.first > 0 && value.second != value.first)) {
+				ok = false;
+			}
+			if (value.first < 0) {
+				sum += value.second;
+			}
+			last = value.first;
+			count++;
+		}
+	};
+
+	static long		key(size_t writer, size_t ops, size_t i)
+	{
+		return static_cast<long>(writer * ops + i + 1);
+	}
+
+	static Walk		walk(ft::sharded_map<long, long> const & map)
+	{
+		Walk	w = { 0, 0, 0, true };
+
+		return map.for_each(w);
+	}
+
+	void	reset(size_t n)
+	{
+		map.clear();
+		threads = n;
+		writers = n == 1 ? 1 : (n + 1) / 2;
+		finished = 0;
+		progress = 0;
+		walks_ok = true;
+	}
+
+	void	run(size_t thread, size_t ops)
+	{
+		if (thread % 2 == 0 || threads == 1) {
+			size_t const	writer = thread / 2;
+
+			if (thread == 0) {
+				this->ops = ops;
+			}
+			for (size_t i = 0; i < ops; i++) {
+				long const	k = key(writer, ops, i);
+
+				map.update(-1 - static_cast<long>(i % counters), Increment());
+				map.insert(ft::make_pair(k, k));
+				if (i % 2) {
+					map.erase(k - 1);
+				}
+				if ((i + 1) % (ops / 16 + 1) == 0) {
+					ft::atomic_fetch_add(&progress, size_t(1));
+				}
+			}
+			ft::atomic_fetch_add(&finished, size_t(1));
+		}
+		else {
+			size_t	walked = size_t(-1);
+
+			do {
+				size_t const	seen = ft::atomic_load(&progress);
+
+				if (seen == walked) {
+					sched_yield();
+					continue ;
+				}
+				if (!walk(map).ok) {
+					ft::atomic_store(&walks_ok, false);
+				}
+				walked = seen;
+			} while (ft::atomic_load(&finished) < writers);
+		}
+	}
+
+	size_t	total(size_t, size_t ops)	{ return writers * ops; }
+
+	// Every writer kept exactly its odd indices, the counters add up to
+	// one increment per operation
+	bool	check()
+	{
+		size_t const	used = std::min(ops, static_cast<size_t>(counters));
+		Walk const		w = walk(map);
+		long			value;
+
+		if (!walks_ok || !w.ok || w.sum != static_cast<long>(writers * ops)
+			|| w.count != used + writers * (ops / 2) || map.size() != w.count) {
+			return false;
+		}
+		for (size_t writer = 0; writer < writers; writer++) {
+			for (size_t i = 0; i < ops; i++) {
+				long const	k = key(writer, ops, i);
+				bool const	found = map.find(k, value);
+
+				if (found != (i % 2 == 1) || (found && value != k)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+};
+
+int		main(int argc, char ** argv)
+{
+	long const		cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t const	ops = argc > 1 ? static_cast<size_t>(atol(argv[1])) : 1000000;
+	size_t const	threads = argc > 2 ? static_cast<size_t>(atol(argv[2]))
+							: cpus > 0 ? static_cast<size_t>(cpus) : 1;
+	bool			ok = true;
+
+	std::cout	<< ITALIC << GREEN << "Stress testing the concurrent containers, "
+				<< ops << " operations per thread" << RESET << std::endl;
+	{
+		LockedStack		bench;
+		ok = run("ft::stack behind a mutex", bench, threads, ops) && ok;
+	}
+	{
+		LockFreeStack	bench;
+		ok = run("ft::concurrent_stack", bench, threads, ops) && ok;
+	}
+	{
+		BatchedStack	bench;
+		ok = run("ft::concurrent_stack, batches of 16", bench, threads, ops) && ok;
+	}
+	{
+		SpscRing		bench;
+		ok = run("ft::spsc_ring, producer and consumer pairs", bench, threads, ops) && ok;
+	}
+	{
+		MpmcRing		bench;
+		ok = run("ft::mpmc_ring, half producers, half consumers", bench, threads, ops) && ok;
+	}
+	{
+		StealingDeque	bench;
+		ok = run("ft::work_stealing_deque, one owner, the rest thieves", bench, threads, ops) && ok;
+	}
+	{
+		ForkJoinSum		bench;
+		ok = run("ft::thread_pool, fork/join sum", bench, threads, ops) && ok;
+	}
+	{
+		ParallelVector	bench;
+		ok = run("ft::vector, parallel fill, copy and compare", bench, threads, ops) && ok;
+	}
+	{
+		ParallelMapLoad	bench;
+		ok = run("ft::map, parallel bulk load and sum", bench, threads, ops) && ok;
+	}
+	{
+		ConcurrentMap	bench;
+		ok = run("ft::concurrent_map, writers and snapshot readers", bench, threads, ops) && ok;
+	}
+	{
+		ShardedMap		bench;
+		ok = run("ft::sharded_map, counters, writers and ordered walks", bench, threads, ops) && ok;
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,616 @@
+#ifndef FT_THREAD_POOL_HPP
+# define FT_THREAD_POOL_HPP
+
+# include <algorithm>
+# include <stdexcept>
+
+# include <pthread.h>
+# include <sched.h>
+# include <unistd.h>
+
+# include "atomic.hpp"
+# include "mutex.hpp"
+# include "deque.hpp"
+# include "vector.hpp"
+# include "work_stealing_deque.hpp"
+
+namespace	ft
+
+{
+
+// Fork/join thread pool over work-stealing deques
+//
+// Every worker owns an ft::work_stealing_deque: tasks submitted from a
+// worker go to the bottom of its own deque and are run LIFO, hot in its
+// cache, while idle workers steal the oldest, largest pieces of work from
+// the top of the others'. Tasks submitted from outside go through one
+// locked injection queue. Idle workers spin briefly, then sleep; they wake
+// on outside submissions and every millisecond to look for work to steal.
+//
+// A task is any copyable functor called with no argument; it must not
+// throw. Tasks are counted in a task_group, and waiting on a group runs
+// pending tasks on the waiting thread, so a task may fork children into
+// a group of its own and wait for them without tying up its worker.
+class	thread_pool
+{
+	// Task groups
+	public:
+		class	task_group
+		{
+			friend class	thread_pool;
+
+			size_t		_pending;
+
+			task_group(task_group const &);
+			task_group &	operator = (task_group const &);
+
+			public:
+				task_group() : _pending(0)		{ }
+
+				bool	done() const	{ return atomic_load(&_pending, memory_order_acquire) == 0; }
+		};
+
+	// Private members
+	private:
+		struct	task
+		{
+			task_group *	group;
+
+			virtual ~task()				{ }
+			virtual void	run() = 0;
+		};
+
+		template < class Function >
+		struct	function_task : public task
+		{
+			Function	f;
+
+			explicit function_task(Function const & f) : f(f)	{ }
+
+			void	run()		{ f(); }
+		};
+
+		struct	worker
+		{
+			thread_pool *					pool;
+			pthread_t						thread;
+			size_t							random;
+			work_stealing_deque<task *>		deque;
+		};
+
+		static const unsigned	_idle_spins = 64;
+		static const long		_sleep_microseconds = 1000;
+
+		ft::vector<worker *>		_workers;
+		mutex						_lock;
+		condition_variable			_wake;
+		ft::deque<task *>			_injected;
+		size_t						_injected_count;
+		size_t						_sleepers;
+		size_t						_pending;
+		bool						_stop;
+		task_group					_default;
+
+	// Constructors
+	public:
+		// 0 threads starts one per online CPU
+		explicit thread_pool (size_t threads = 0)
+			: _injected_count(0), _sleepers(0), _pending(0), _stop(false)
+		{
+			size_t	started = 0;
+
+			if (threads == 0) {
+				long const	cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+				threads = cpus > 0 ? static_cast<size_t>(cpus) : 1;
+			}
+			try {
+				_workers.reserve(threads);
+				for (size_t i = 0; i < threads; i++) {
+					_workers.push_back(new worker());
+					_workers.back()->pool = this;
+					_workers.back()->random = hash_mix(i + 1) | 1;
+				}
+				for (; started < threads; started++) {
+					if (pthread_create(&_workers[started]->thread, NULL, _main, _workers[started]) != 0) {
+						throw std::runtime_error("thread_pool::thread_pool()::thread_create_failed");
+					}
+				}
+			}
+			catch (...) {
+				_shutdown(started);
+				throw;
+			}
+		}
+
+		// Runs every task submitted so far, then stops the workers
+		~thread_pool()
+		{
+			while (atomic_load(&_pending, memory_order_acquire)) {
+				if (!_run_one(NULL)) {
+					sched_yield();
+				}
+			}
+			_shutdown(_workers.size());
+		}
+
+	// Capacity
+		size_t			size() const	{ return _workers.size(); }
+
+	// Tasks
+		template < class Function >
+		void			submit(Function const & f)
+		{
+			submit(_default, f);
+		}
+
+		template < class Function >
+		void			submit(task_group & group, Function const & f)
+		{
+			task *		t = new function_task<Function>(f);
+			worker *	self = _current();
+
+			t->group = &group;
+			atomic_fetch_add(&group._pending, size_t(1), memory_order_relaxed);
+			atomic_fetch_add(&_pending, size_t(1), memory_order_relaxed);
+			try {
+				if (self && self->pool == this) {
+					self->deque.push(t);
+				}
+				else {
+					lock_guard<mutex>	guard(_lock);
+
+					_injected.push_back(t);
+					atomic_store(&_injected_count, _injected.size(), memory_order_release);
+				}
+			}
+			catch (...) {
+				atomic_fetch_sub(&_pending, size_t(1), memory_order_relaxed);
+				atomic_fetch_sub(&group._pending, size_t(1), memory_order_relaxed);
+				delete t;
+				throw;
+			}
+			if (atomic_load(&_sleepers, memory_order_relaxed)) {
+				_wake.notify_one();
+			}
+		}
+
+		// Waits for the tasks submitted without a group; not from a task,
+		// which would be waiting for itself
+		void			wait()
+		{
+			wait(_default);
+		}
+
+		// Runs pending tasks, of any group, until group is done
+		void			wait(task_group & group)
+		{
+			worker *	self = _current();
+			unsigned	idle = 0;
+
+			if (self && self->pool != this) {
+				self = NULL;
+			}
+			while (!group.done()) {
+				if (_run_one(self)) {
+					idle = 0;
+				}
+				else if (++idle < _idle_spins) {
+					cpu_relax();
+				}
+				else {
+					sched_yield();
+				}
+			}
+		}
+
+	// Private member functions
+	private:
+		thread_pool (thread_pool const &);
+		thread_pool &	operator = (thread_pool const &);
+
+		// Worker the calling thread is, if any
+		static worker *&	_current()
+		{
+			static __thread worker *	current = NULL;
+
+			return current;
+		}
+
+		static void *	_main(void * arg)
+		{
+			worker *		self = static_cast<worker *>(arg);
+			thread_pool &	pool = *self->pool;
+			unsigned		idle = 0;
+
+			_current() = self;
+			for (;;) {
+				if (pool._run_one(self)) {
+					idle = 0;
+					continue ;
+				}
+				if (atomic_load(&pool._stop, memory_order_acquire)) {
+					break ;
+				}
+				if (++idle < _idle_spins) {
+					sched_yield();
+					continue ;
+				}
+
+				lock_guard<mutex>	guard(pool._lock);
+
+				atomic_fetch_add(&pool._sleepers, size_t(1));
+				if (!pool._stop && pool._injected.empty()) {
+					pool._wake.wait_for(pool._lock, _sleep_microseconds);
+				}
+				atomic_fetch_sub(&pool._sleepers, size_t(1));
+				idle = 0;
+			}
+			return NULL;
+		}
+
+		// Own deque first, then the injection queue, then one round of
+		// steals starting at a random victim
+		task *			_find(worker * self)
+		{
+			task *	t;
+
+			if (self && self->deque.pop(t)) {
+				return t;
+			}
+			if (atomic_load(&_injected_count, memory_order_acquire)) {
+				lock_guard<mutex>	guard(_lock);
+
+				if (!_injected.empty()) {
+					t = _injected.front();
+					_injected.pop_front();
+					atomic_store(&_injected_count, _injected.size(), memory_order_release);
+					return t;
+				}
+			}
+
+			size_t const	n = _workers.size();
+			size_t			start = 0;
+
+			if (self) {
+				self->random ^= self->random << 13;
+				self->random ^= self->random >> 7;
+				self->random ^= self->random << 17;
+				start = self->random;
+			}
+			for (size_t i = 0; i < n; i++) {
+				worker *	victim = _workers[(start + i) % n];
+
+				if (victim != self && victim->deque.steal(t)) {
+					return t;
+				}
+			}
+			return NULL;
+		}
+
+		bool			_run_one(worker * self)
+		{
+			task *	t = _find(self);
+
+			if (!t) {
+				return false;
+			}
+
+			task_group *	group = t->group;
+
+			t->run();
+			delete t;
+			atomic_fetch_sub(&_pending, size_t(1), memory_order_release);
+			atomic_fetch_sub(&group->_pending, size_t(1), memory_order_release);
+			return true;
+		}
+
+		void			_shutdown(size_t started)
+		{
+			{
+				lock_guard<mutex>	guard(_lock);
+
+				atomic_store(&_stop, true, memory_order_release);
+				_wake.notify_all();
+			}
+			for (size_t i = 0; i < started; i++) {
+				pthread_join(_workers[i]->thread, NULL);
+			}
+			for (size_t i = 0; i < _workers.size(); i++) {
+				delete _workers[i];
+			}
+			_workers.clear();
+		}
+
+};
+
+// Parallel algorithms
+//
+// [0, n) is cut into one contiguous block per worker, fewer when a block
+// would get under grain elements, and f(first, last) is called once per
+// block: the caller runs the first block and helps with the others while it
+// waits. Which thread runs which block is unspecified, any idle worker may
+// steal it, so nothing here places memory on a NUMA node. f is copied once
+// per block and must not throw. If submitting a block fails, the blocks
+// already submitted are waited for before the exception is rethrown.
+
+template < class Function >
+struct	_parallel_block
+{
+	Function	f;
+	size_t		first;
+	size_t		last;
+
+	_parallel_block(Function const & f, size_t first, size_t last)
+		: f(f), first(first), last(last)		{ }
+
+	void	operator () ()		{ f(first, last); }
+};
+
+template < class Function >
+void	parallel_for(thread_pool & pool, size_t n, Function f, size_t grain)
+{
+	size_t	blocks = pool.size();
+
+	if (grain == 0) {
+		grain = 1;
+	}
+	if (blocks > n / grain) {
+		blocks = n / grain;
+	}
+	if (blocks <= 1) {
+		if (n) {
+			f(0, n);
+		}
+		return ;
+	}
+
+	thread_pool::task_group	group;
+	size_t const			step = n / blocks;
+	size_t const			extra = n % blocks;
+	size_t					first = step + (extra != 0);
+
+	try {
+		for (size_t i = 1; i < blocks; i++) {
+			size_t const	last = first + step + (i < extra);
+
+			pool.submit(group, _parallel_block<Function>(f, first, last));
+			first = last;
+		}
+	}
+	catch (...) {
+		pool.wait(group);
+		throw;
+	}
+	f(0, step + (extra != 0));
+	pool.wait(group);
+}
+
+template < class Function >
+void	parallel_for(thread_pool & pool, size_t n, Function f)
+{
+	parallel_for(pool, n, f, 1024);
+}
+
+template < class RandomIt, class UnaryFunction >
+struct	_for_each_block
+{
+	RandomIt		base;
+	UnaryFunction	f;
+
+	_for_each_block(RandomIt base, UnaryFunction const & f) : base(base), f(f)	{ }
+
+	void	operator () (size_t first, size_t last)
+	{
+		for (; first < last; first++) {
+			f(base[first]);
+		}
+	}
+};
+
+template < class RandomIt, class UnaryFunction >
+void	parallel_for_each(thread_pool & pool, RandomIt first, RandomIt last, UnaryFunction f)
+{
+	parallel_for(pool, last - first, _for_each_block<RandomIt, UnaryFunction>(first, f));
+}
+
+template < class RandomIt, class OutputIt, class UnaryOperation >
+struct	_transform_block
+{
+	RandomIt		base;
+	OutputIt		out;
+	UnaryOperation	op;
+
+	_transform_block(RandomIt base, OutputIt out, UnaryOperation const & op)
+		: base(base), out(out), op(op)		{ }
+
+	void	operator () (size_t first, size_t last)
+	{
+		for (; first < last; first++) {
+			out[first] = op(base[first]);
+		}
+	}
+};
+
+// out must be random access too, and not overlap [first, last) unless it
+// is first itself
+template < class RandomIt, class OutputIt, class UnaryOperation >
+OutputIt	parallel_transform(thread_pool & pool, RandomIt first, RandomIt last,
+							   OutputIt out, UnaryOperation op)
+{
+	size_t const	n = last - first;
+
+	parallel_for(pool, n, _transform_block<RandomIt, OutputIt, UnaryOperation>(first, out, op));
+	return out + n;
+}
+
+template < class InputIterator1, class InputIterator2 >
+struct	_equal_block
+{
+	InputIterator1		base1;
+	InputIterator2		base2;
+	bool *				differ;
+
+	_equal_block(InputIterator1 base1, InputIterator2 base2, bool * differ)
+		: base1(base1), base2(base2), differ(differ)		{ }
+
+	// A block stops early once any block found a difference
+	void	operator () (size_t first, size_t last)
+	{
+		size_t const	stride = 4096;
+
+		while (first < last && !atomic_load(differ, memory_order_relaxed)) {
+			size_t const	end = last - first > stride ? first + stride : last;
+
+			if (!ft::equal(base1 + first, base1 + end, base2 + first)) {
+				atomic_store(differ, true, memory_order_relaxed);
+			}
+			first = end;
+		}
+	}
+};
+
+template < class InputIterator1, class InputIterator2 >
+bool	parallel_equal(thread_pool & pool, InputIterator1 first1, InputIterator1 last1,
+					   InputIterator2 first2)
+{
+	bool	differ = false;
+
+	parallel_for(pool, last1 - first1,
+				 _equal_block<InputIterator1, InputIterator2>(first1, first2, &differ));
+	return !differ;
+}
+
+// Parallel ft::vector fill, copy and compare. The vector is sized on the
+// calling thread, leaving trivial elements uninitialized, and its elements
+// are then assigned in blocks of at least 64 KB on pool; T must be default
+// constructible and its assignment must not throw.
+
+template < class T >
+struct	_fill_block
+{
+	T *				out;
+	T const *		value;
+
+	_fill_block(T * out, T const * value) : out(out), value(value)		{ }
+
+	void	operator () (size_t first, size_t last)
+	{
+		std::fill(out + first, out + last, *value);
+	}
+};
+
+template < class T >
+struct	_copy_block
+{
+	T *				out;
+	T const *		from;
+
+	_copy_block(T * out, T const * from) : out(out), from(from)		{ }
+
+	void	operator () (size_t first, size_t last)
+	{
+		std::copy(from + first, from + last, out + first);
+	}
+};
+
+template < class T >
+size_t	_parallel_grain()
+{
+	return sizeof(T) < 65536 ? 65536 / sizeof(T) : 1;
+}
+
+// Replaces the contents of v with n copies of value
+template < class T, class Alloc, class Growth >
+void	parallel_fill(thread_pool & pool, vector<T, Alloc, Growth> & v, size_t n, T const & value)
+{
+	T const		tmp(value);
+
+	v.clear();
+	v.resize_default_init(n);
+	parallel_for(pool, n, _fill_block<T>(v.data(), &tmp), _parallel_grain<T>());
+}
+
+// Replaces the contents of v with those of other
+template < class T, class Alloc, class Growth >
+void	parallel_copy(thread_pool & pool, vector<T, Alloc, Growth> & v,
+					  vector<T, Alloc, Growth> const & other)
+{
+	if (&v == &other) {
+		return ;
+	}
+	v.clear();
+	v.resize_default_init(other.size());
+	parallel_for(pool, other.size(), _copy_block<T>(v.data(), other.data()), _parallel_grain<T>());
+}
+
+// operator == comparing blocks on pool
+template < class T, class Alloc, class Growth >
+bool	parallel_equal(thread_pool & pool, vector<T, Alloc, Growth> const & lhs,
+					   vector<T, Alloc, Growth> const & rhs)
+{
+	return lhs.size() == rhs.size()
+		&& parallel_equal(pool, lhs.data(), lhs.data() + lhs.size(), rhs.data());
+}
+
+// Stable: one block per worker is stable sorted, then neighbouring runs are
+// merged pairwise, each round's merges in parallel
+template < class RandomIt, class Compare >
+struct	_sort_block
+{
+	RandomIt	base;
+	size_t		n;
+	size_t		blocks;
+	size_t		width;			// runs merged this round, 0 to sort them
+	Compare		comp;
+
+	_sort_block(RandomIt base, size_t n, size_t blocks, size_t width, Compare const & comp)
+		: base(base), n(n), blocks(blocks), width(width), comp(comp)		{ }
+
+	size_t	bound(size_t run) const
+	{
+		if (run >= blocks) {
+			return n;
+		}
+		return n / blocks * run + n % blocks * run / blocks;
+	}
+
+	void	operator () (size_t first, size_t last)
+	{
+		for (; first < last; first++) {
+			if (width == 0) {
+				std::stable_sort(base + bound(first), base + bound(first + 1), comp);
+			}
+			else {
+				size_t const	run = 2 * width * first;
+
+				std::inplace_merge(base + bound(run), base + bound(run + width),
+								   base + bound(run + 2 * width), comp);
+			}
+		}
+	}
+};
+
+template < class RandomIt, class Compare >
+void	parallel_sort(thread_pool & pool, RandomIt first, RandomIt last, Compare comp)
+{
+	size_t const	n = last - first;
+	size_t			blocks = pool.size();
+
+	if (blocks > n / 4096) {
+		blocks = n / 4096;
+	}
+	if (blocks <= 1) {
+		std::stable_sort(first, last, comp);
+		return ;
+	}
+	parallel_for(pool, blocks, _sort_block<RandomIt, Compare>(first, n, blocks, 0, comp), 1);
+	for (size_t width = 1; width < blocks; width *= 2) {
+		parallel_for(pool, (blocks + 2 * width - 1) / (2 * width),
+					 _sort_block<RandomIt, Compare>(first, n, blocks, width, comp), 1);
+	}
+}
+
+}
+
+#endif
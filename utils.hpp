@@ -1,6 +1,8 @@
 #ifndef UTILS_HPP
 # define UTILS_HPP
 
+# include <string>
+
 namespace ft
 
 {
@@ -29,6 +31,86 @@ template < >	struct is_integral < unsigned int >			{ static const bool value = t
 template < >	struct is_integral < unsigned long >		{ static const bool value = true; };
 template < >	struct is_integral < unsigned long long >	{ static const bool value = true; };
 
+template < class T, T v >
+struct	integral_constant
+{
+	typedef T					value_type;
+	typedef integral_constant	type;
+
+	static const T	value = v;
+};
+
+typedef integral_constant<bool, true>	true_type;
+typedef integral_constant<bool, false>	false_type;
+
+template < class T, class U >	struct is_same				: public false_type	{ };
+template < class T >			struct is_same < T, T >		: public true_type	{ };
+
+template < class T >	struct is_floating_point				{ static const bool value = false; };
+
+template < >	struct is_floating_point < float >				{ static const bool value = true; };
+template < >	struct is_floating_point < double >				{ static const bool value = true; };
+template < >	struct is_floating_point < long double >		{ static const bool value = true; };
+
+template < class T >
+struct	is_arithmetic
+{
+	static const bool	value = is_integral<T>::value || is_floating_point<T>::value;
+};
+
+template < class T >
+struct	is_trivially_default_constructible
+{
+# if defined(__GNUC__) || defined(__clang__)
+	static const bool	value = __is_trivially_constructible(T);
+# else
+	static const bool	value = is_integral<T>::value;
+# endif
+};
+
+template < class T >
+struct	is_trivially_copyable
+{
+# if defined(__GNUC__) || defined(__clang__)
+	static const bool	value = __is_trivially_copyable(T);
+# else
+	static const bool	value = is_integral<T>::value;
+# endif
+};
+
+template < class T >
+struct	alignment_of
+{
+	struct	probe	{ char c; T t; };
+
+	static const size_t	value = sizeof(probe) - sizeof(T);
+};
+
+// Tag selecting constructors that leave trivial elements uninitialized
+struct	default_init_t											{ };
+default_init_t const	default_init = default_init_t();
+
+// Raw storage for N objects of type T, aligned for any fundamental type
+template < class T, size_t N >
+union	aligned_buffer
+{
+	char			data[sizeof(T) * N];
+	long double		_align_ld;
+	long long		_align_ll;
+	void *			_align_ptr;
+	void			(*_align_fn)();
+
+	T *				ptr()				{ return reinterpret_cast<T *>(data); }
+	T const *		ptr() const			{ return reinterpret_cast<T const *>(data); }
+};
+
+// Elements per block of chunked containers: 4 KB blocks, at least 16 elements
+template < class T >
+struct	block_size
+{
+	static const size_t	value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+};
+
 
 template < class InputIterator1, class InputIterator2 >
 bool		lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
@@ -96,6 +178,8 @@ struct	pair
 
 	pair (T1 const & a, T2 const & b)	: first(a), second(b)				 { }
 
+	pair (pair const & other)			: first(other.first), second(other.second) { }
+
 	template < class U1, class U2 >
 	pair (pair<U1, U2> const & pr)		: first(pr.first), second(pr.second) { }
 
@@ -156,6 +240,101 @@ struct	less		: public binary_function<T, T, bool>
 	}
 };
 
+template < class T >
+struct	greater		: public binary_function<T, T, bool>
+{
+	bool			operator () (T const & lhs, T const & rhs) const {
+		return lhs > rhs;
+	}
+};
+
+// Hash for sharding and bucketing. Integers and pointers are mixed with
+// the 64-bit finalizer of MurmurHash3 so close keys land far apart,
+// floating-point values are hashed by value, strings and other trivially
+// copyable types hash their bytes (FNV-1a); anything else, or a
+// type whose equal values differ in padding, needs its own hash functor
+inline size_t	hash_mix(unsigned long long x)
+{
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	x ^= x >> 33;
+	return static_cast<size_t>(x);
+}
+
+inline size_t	hash_bytes(void const * p, size_t n)
+{
+	unsigned char const *	bytes = static_cast<unsigned char const *>(p);
+	unsigned long long		h = 0xcbf29ce484222325ULL;
+
+	for (size_t i = 0; i < n; i++) {
+		h = (h ^ bytes[i]) * 0x100000001b3ULL;
+	}
+	return static_cast<size_t>(h);
+}
+
+template < class T >
+struct	hash		: public unary_function<T, size_t>
+{
+	size_t			operator () (T const & x) const {
+		return _hash(x, integral_constant<bool, is_integral<T>::value>());
+	}
+
+	private:
+		typedef char	_requires_trivially_copyable[is_trivially_copyable<T>::value ? 1 : -1];
+
+		static size_t	_hash(T const & x, true_type)	{ return hash_mix(static_cast<unsigned long long>(x)); }
+		static size_t	_hash(T const & x, false_type)	{ return hash_bytes(&x, sizeof(x)); }
+};
+
+template < class T >
+struct	hash < T * >	: public unary_function<T *, size_t>
+{
+	size_t			operator () (T * x) const {
+		return hash_mix(reinterpret_cast<size_t>(x));
+	}
+};
+
+// Floating-point keys hash by value: -0.0 compares equal to 0.0 so it is
+// folded into it, and long double goes through double, its bytes having
+// padding. Equal values always hash the same; distinct long doubles that
+// round to the same double collide
+inline size_t	hash_float(double x)
+{
+	if (x == 0.0) {
+		x = 0.0;
+	}
+	return hash_bytes(&x, sizeof(x));
+}
+
+template < >
+struct	hash < float >			: public unary_function<float, size_t>
+{
+	size_t			operator () (float x) const			{ return hash_float(x); }
+};
+
+template < >
+struct	hash < double >			: public unary_function<double, size_t>
+{
+	size_t			operator () (double x) const		{ return hash_float(x); }
+};
+
+template < >
+struct	hash < long double >	: public unary_function<long double, size_t>
+{
+	size_t			operator () (long double x) const	{ return hash_float(static_cast<double>(x)); }
+};
+
+template < class CharT, class Traits, class Alloc >
+struct	hash < std::basic_string<CharT, Traits, Alloc> >
+	: public unary_function<std::basic_string<CharT, Traits, Alloc>, size_t>
+{
+	size_t			operator () (std::basic_string<CharT, Traits, Alloc> const & x) const {
+		return hash_bytes(x.data(), x.size() * sizeof(CharT));
+	}
+};
+
 template < class T >
 struct	identity	: public unary_function<T,T>
 {
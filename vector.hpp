@@ -5,18 +5,20 @@
 
 # include "iterator.hpp"
 # include "utils.hpp"
+# include "growth_policy.hpp"
 
 namespace	ft
 
 {
 
-template < class T, class Allocator = std::allocator<T> >
+template < class T, class Allocator = std::allocator<T>, class GrowthPolicy = growth_double >
 class	vector
 {
 	// Type definitions
 	public:
 		typedef T											value_type;
 		typedef Allocator									allocator_type;
+		typedef GrowthPolicy								growth_policy;
 		typedef typename allocator_type::size_type			size_type;
 		typedef typename allocator_type::difference_type	difference_type;
 		typedef typename allocator_type::reference			reference;
@@ -54,6 +56,14 @@ class	vector
 			}
 		}
 
+		// Trivially constructible elements are left uninitialized
+		vector	(size_type count, default_init_t,
+				 allocator_type const & alloc = allocator_type())
+			: _start(NULL), _end(NULL), _end_cap(NULL), _alloc(alloc)
+		{
+			resize_default_init(count);
+		}
+
 		template < class InputIterator >
 		vector	(InputIterator first, InputIterator last,
 				 allocator_type const & alloc = allocator_type(),
@@ -97,6 +107,7 @@ class	vector
 		size_type		capacity() const	{ return static_cast<size_type>(_end_cap - _start); }
 		size_type		max_size() const	{ return _alloc.max_size(); }
 		bool			empty() const		{ return _start == _end; }
+		size_type		wasted_bytes() const	{ return (capacity() - size()) * sizeof(value_type); }
 
 		void			resize(size_type n, value_type value = value_type())
 		{
@@ -112,6 +123,25 @@ class	vector
 			}
 		}
 
+		// Like resize() but new trivially constructible elements keep whatever
+		// the storage held, for buffers that are about to be overwritten
+		void			resize_default_init(size_type n)
+		{
+			if (n < size()) {
+				_destroy_after_pos(_start + n);
+			}
+			else if (n > capacity()) {
+				reserve(_recommend(n));
+			}
+			if (is_trivially_default_constructible<value_type>::value) {
+				_end = _start + n;
+			}
+			while (_end < _start + n) {
+				_construct_wrapper(_end, value_type());
+				_end++;
+			}
+		}
+
 		void			reserve(size_type n)
 		{
 			pointer		new_ptr;
@@ -133,6 +163,35 @@ class	vector
 			_end_cap = _start + n;
 		}
 
+		// Reallocates to exactly size() elements, releasing all spare capacity
+		void			shrink_to_fit()
+		{
+			size_type	_size = size();
+			pointer		new_ptr = NULL;
+
+			if (_size == capacity())
+				return ;
+			if (_size) {
+				new_ptr = _alloc.allocate(_size);
+				for (size_type i = 0; i < _size; i++) {
+					try {
+						_alloc.construct(new_ptr + i, *(_start + i));
+					}
+					catch (...) {
+						while (i)
+							_alloc.destroy(new_ptr + --i);
+						_alloc.deallocate(new_ptr, _size);
+						throw;
+					}
+				}
+			}
+			clear();
+			_alloc.deallocate(_start, capacity());
+			_start = new_ptr;
+			_end = _start + _size;
+			_end_cap = _end;
+		}
+
 	// Modifiers
 		template < class InputIterator >
 		void			assign(InputIterator first, InputIterator last,
@@ -158,12 +217,7 @@ class	vector
 
 		void			push_back(value_type const & value)
 		{
-			size_type	cap = capacity();
-
-			if (cap == 0) {
-				reserve(1);
-			}
-			else if (size() + 1 > cap) {
+			if (_end == _end_cap) {
 				reserve(_recommend(size() + 1));
 			}
 			_construct_wrapper(_end, value);
@@ -246,6 +300,7 @@ class	vector
 			std::swap(_start, other._start);
 			std::swap(_end, other._end);
 			std::swap(_end_cap, other._end_cap);
+			std::swap(_alloc, other._alloc);
 		}
 
 		void			clear()							{ _destroy_after_pos(_start); }
@@ -273,8 +328,8 @@ class	vector
 			return	_start[n];
 		}
 
-		// pointer			data()							{ return _start; }
-		// pointer const	data() const					{ return _start; }
+		pointer			data()							{ return _start; }
+		const_pointer	data() const					{ return _start; }
 
 	// Iterators
 		iterator				begin()			{ return iterator(_start); }
@@ -318,31 +373,14 @@ class	vector
 			std::rotate(first - offset, first, last);
 		}
 
-		size_type		_size_after_power2(size_type size)
-		{
-			size_type	new_size = 1;
-
-			if (size > max_size()) {
-				throw std::length_error("vector::allocator()::length_error");
-			}
-			while (new_size < size) {
-				new_size *= 2;
-			}
-			return new_size;
-		}
-
 		size_type		_recommend(size_type new_size) const
 		{
 			size_type const		max_sz = max_size();
-			size_type const		cap = capacity();
 
 			if (new_size > max_sz) {
 				throw std::length_error("vector::reserve()::length_error");
 			}
-			if (cap >= max_sz / 2) {
-				return max_sz;
-			}
-			return std::max<size_type>(2 * cap, new_size);
+			return growth_policy::recommend(capacity(), new_size, max_sz, sizeof(value_type));
 		}
 
 	// Non-member overloads
@@ -368,8 +406,8 @@ class	vector
 
 };
 
-	template < class T, class Alloc >
-	void	swap(vector<T, Alloc> & lhs, vector<T, Alloc> & rhs)
+	template < class T, class Alloc, class Growth >
+	void	swap(vector<T, Alloc, Growth> & lhs, vector<T, Alloc, Growth> & rhs)
 	{
 		lhs.swap(rhs);
 	}
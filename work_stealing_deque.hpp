@@ -0,0 +1,219 @@
+#ifndef FT_WORK_STEALING_DEQUE_HPP
+# define FT_WORK_STEALING_DEQUE_HPP
+
+# include <memory>
+
+# include "atomic.hpp"
+# include "vector.hpp"
+# include "utils.hpp"
+
+namespace	ft
+
+{
+
+// Chase-Lev work-stealing deque
+//
+// One owner thread pushes and pops at the bottom, LIFO, without any
+// read-modify-write unless it races a thief for the last element; any
+// number of thieves steal at the top, FIFO, with one compare and exchange.
+// Storage is a circular array the owner doubles when full: thieves may
+// still be reading the old one, so it is kept until the deque is destroyed,
+// at most as much memory again as the final array.
+//
+// A thief reads an element before knowing its claim succeeded, and drops
+// it if not: elements are copied as single atomic words, so T must be
+// trivially copyable and no larger than a pointer, typically a task pointer.
+template < class T, class Allocator = std::allocator<T> >
+class	work_stealing_deque
+{
+	// Type definitions
+	public:
+		typedef T											value_type;
+		typedef Allocator									allocator_type;
+		typedef typename allocator_type::size_type			size_type;
+		typedef typename allocator_type::difference_type	difference_type;
+
+	// Private members
+	private:
+		typedef char	_requires_trivially_copyable[is_trivially_copyable<T>::value ? 1 : -1];
+		typedef char	_requires_word_sized[sizeof(T) <= sizeof(void *)
+											 && (sizeof(T) & (sizeof(T) - 1)) == 0 ? 1 : -1];
+
+		struct	array
+		{
+			T *			slots;
+			size_type	mask;
+		};
+
+		typedef typename Allocator::template rebind<array>::other	array_allocator;
+
+		padded<difference_type>		_top;		// next to steal, advanced by thieves
+		padded<difference_type>		_bottom;	// next free slot, owned by the owner
+		padded<array *>				_array;
+		ft::vector<array *>			_retired;
+		allocator_type				_alloc;
+		array_allocator				_array_alloc;
+
+	// Constructors
+	public:
+		// capacity is rounded up to a power of two; the deque grows past it
+		explicit work_stealing_deque (size_type capacity = 64,
+									  allocator_type const & alloc = allocator_type())
+			: _alloc(alloc), _array_alloc(alloc)
+		{
+			size_type	n = 1;
+
+			while (n < capacity) {
+				n <<= 1;
+			}
+			_top.value = 0;
+			_bottom.value = 0;
+			_array.value = _new_array(n);
+		}
+
+		// No thread may be using the deque
+		~work_stealing_deque()
+		{
+			_delete_array(_array.value);
+			for (size_type i = 0; i < _retired.size(); i++) {
+				_delete_array(_retired[i]);
+			}
+		}
+
+	// Capacity
+		// Exact on the owner's thread when no steal is in flight, a hint
+		// anywhere else
+		size_type		size() const
+		{
+			difference_type const	b = atomic_load(&_bottom.value, memory_order_relaxed);
+			difference_type const	t = atomic_load(&_top.value, memory_order_relaxed);
+
+			return b > t ? static_cast<size_type>(b - t) : 0;
+		}
+
+		bool			empty() const		{ return size() == 0; }
+
+	// Owner
+		void			push(value_type value)
+		{
+			difference_type const	b = atomic_load(&_bottom.value, memory_order_relaxed);
+			difference_type const	t = atomic_load(&_top.value, memory_order_acquire);
+			array *					a = atomic_load(&_array.value, memory_order_relaxed);
+
+			if (static_cast<size_type>(b - t) > a->mask) {
+				a = _grow(a, t, b);
+			}
+			_put(a, b, value);
+			atomic_thread_fence(memory_order_release);
+			atomic_store(&_bottom.value, b + 1, memory_order_relaxed);
+		}
+
+		// Takes the most recently pushed element; false when empty
+		bool			pop(value_type & value)
+		{
+			difference_type const	b = atomic_load(&_bottom.value, memory_order_relaxed) - 1;
+			array * const			a = atomic_load(&_array.value, memory_order_relaxed);
+			difference_type			t;
+			bool					taken = true;
+
+			// Reserving the bottom slot before reading top: a thief that
+			// read the old bottom is then seen here through top
+			atomic_store(&_bottom.value, b, memory_order_relaxed);
+			atomic_thread_fence();
+			t = atomic_load(&_top.value, memory_order_relaxed);
+			if (t > b) {
+				atomic_store(&_bottom.value, b + 1, memory_order_relaxed);
+				return false;
+			}
+			value = _get(a, b);
+			if (t == b) {
+				// Last element: race the thieves for it
+				taken = atomic_compare_exchange(&_top.value, t, t + 1);
+				atomic_store(&_bottom.value, b + 1, memory_order_relaxed);
+			}
+			return taken;
+		}
+
+	// Thieves
+		// Takes the oldest element; false when empty or lost to another
+		// thread, in which case retrying may succeed
+		bool			steal(value_type & value)
+		{
+			difference_type	t = atomic_load(&_top.value, memory_order_acquire);
+
+			atomic_thread_fence();
+
+			difference_type const	b = atomic_load(&_bottom.value, memory_order_acquire);
+
+			if (t >= b) {
+				return false;
+			}
+			value = _get(atomic_load(&_array.value, memory_order_acquire), t);
+			return atomic_compare_exchange(&_top.value, t, t + 1);
+		}
+
+		allocator_type	get_allocator() const	{ return _alloc; }
+
+	// Private member functions
+	private:
+		work_stealing_deque (work_stealing_deque const &);
+		work_stealing_deque &	operator = (work_stealing_deque const &);
+
+		static value_type	_get(array const * a, difference_type i)
+		{
+			value_type	value;
+
+			__atomic_load(a->slots + (static_cast<size_type>(i) & a->mask), &value, __ATOMIC_RELAXED);
+			return value;
+		}
+
+		static void			_put(array * a, difference_type i, value_type value)
+		{
+			__atomic_store(a->slots + (static_cast<size_type>(i) & a->mask), &value, __ATOMIC_RELAXED);
+		}
+
+		array *			_new_array(size_type n)
+		{
+			array *	a = _array_alloc.allocate(1);
+
+			try {
+				a->slots = _alloc.allocate(n);
+			}
+			catch (...) {
+				_array_alloc.deallocate(a, 1);
+				throw;
+			}
+			a->mask = n - 1;
+			return a;
+		}
+
+		void			_delete_array(array * a)
+		{
+			_alloc.deallocate(a->slots, a->mask + 1);
+			_array_alloc.deallocate(a, 1);
+		}
+
+		// Copies [t, b) into an array twice as large and publishes it
+		array *			_grow(array * a, difference_type t, difference_type b)
+		{
+			array *	bigger = _new_array(2 * (a->mask + 1));
+
+			try {
+				_retired.push_back(a);
+			}
+			catch (...) {
+				_delete_array(bigger);
+				throw;
+			}
+			for (difference_type i = t; i < b; i++) {
+				_put(bigger, i, _get(a, i));
+			}
+			atomic_store(&_array.value, bigger, memory_order_release);
+			return bigger;
+		}
+
+};
+
+}
+
+#endif